@@ -0,0 +1,270 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include "benchfixture.h"
+
+// Every allocation in the process is counted, so a benchmark can report how
+// many allocations each call makes.
+static std::atomic<uint64_t> num_allocations(0);
+
+void* operator new(size_t size) {
+  num_allocations.fetch_add(1, std::memory_order_relaxed);
+  void* memory = malloc(size ? size : 1);
+
+  if (!memory) {
+    throw std::bad_alloc();
+  }
+
+  return memory;
+}
+
+void operator delete(void* memory) noexcept { free(memory); }
+void operator delete(void* memory, size_t) noexcept { free(memory); }
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Fixtures = std::vector<std::shared_ptr<BenchFixture>>;
+
+// Each call returns a size so the work can't be optimized away
+struct Benchmark {
+  const char* name;
+  std::function<size_t(const BenchFixture&)> call;
+};
+
+struct Result {
+  std::string name;
+  unsigned num_loose;
+  unsigned num_builds;
+  uint64_t num_calls;
+  double mean;
+  double p50;
+  double p90;
+  double p99;
+  double allocations;
+};
+
+const unsigned kLooseCounts[] = {4, 8, 12, 16, 20, 24};
+const unsigned kBuildCounts[] = {0, 2, 4, 6};
+const unsigned kNumVariants = 8;
+const uint64_t kMinSampleNanos = 200000;
+
+volatile size_t sink;
+
+// Each call rewinds the thread arena, as a move does, so the scratch memory
+// of one call is reused by the next
+const Benchmark kBenchmarks[] = {
+  {"FindBestCapture", [](const BenchFixture& fixture) {
+    Arena::Scope scratch;
+    return (size_t) fixture.player->FindBestCapture(fixture.table)
+        ->GetScore();
+  }},
+  {"FindBestBuild", [](const BenchFixture& fixture) {
+    Arena::Scope scratch;
+    return (size_t) fixture.player->FindBestBuild(fixture.table)->GetScore();
+  }},
+  {"FindBestSingleBuild", [](const BenchFixture& fixture) {
+    Arena::Scope scratch;
+    return (size_t) fixture.player->FindBestSingleBuild(0, fixture.table)
+        ->GetScore();
+  }},
+  {"FindBestMultiBuild", [](const BenchFixture& fixture) {
+    Arena::Scope scratch;
+    return (size_t) fixture.player->FindBestMultiBuild(0, fixture.table)
+        ->GetScore();
+  }},
+  {"FindBestIncreaseBuild", [](const BenchFixture& fixture) {
+    Arena::Scope scratch;
+    return (size_t) fixture.player->FindBestIncreaseBuild(0, fixture.table)
+        ->GetScore();
+  }},
+  {"GetAllValidSets", [](const BenchFixture& fixture) {
+    Arena::Scope scratch;
+    return fixture.player->GetAllValidSets(fixture.value, fixture.table)
+        .size();
+  }},
+  {"GetBestValidSetOfSets", [](const BenchFixture& fixture) {
+    Arena::Scope scratch;
+    unsigned score = 0;
+    return (size_t) fixture.player->GetBestValidSetOfSets(fixture.value,
+        fixture.table, 0, score);
+  }},
+};
+
+/**
+ * Description: Times a batch of calls, cycling through the fixtures.
+ * Parameters: const Benchmark& benchmark: The function to call.
+ * const Fixtures& fixtures: The fixtures to call it on.
+ * const uint64_t& num_calls: The number of calls.
+ * Returns: The elapsed nanoseconds.
+ */
+
+uint64_t TimeBatch(const Benchmark& benchmark, const Fixtures& fixtures,
+    const uint64_t& num_calls) {
+  Clock::time_point start = Clock::now();
+
+  for (uint64_t i = 0; i < num_calls; i++) {
+    sink = benchmark.call(*fixtures[i % fixtures.size()]);
+  }
+
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      Clock::now() - start).count();
+}
+
+/**
+ * Description: Runs one benchmark on one density. The batch size is doubled
+ *     until a batch takes long enough to time, then each sample times one
+ *     batch.
+ * Parameters: const Benchmark& benchmark: The function to call.
+ * const Fixtures& fixtures: The fixture variants of the density.
+ * const unsigned& num_samples: The number of samples.
+ * Returns: The result.
+ */
+
+Result Run(const Benchmark& benchmark, const Fixtures& fixtures,
+    const unsigned& num_samples) {
+  uint64_t batch = fixtures.size();
+
+  while (TimeBatch(benchmark, fixtures, batch) < kMinSampleNanos) {
+    batch *= 2;
+  }
+
+  std::vector<double> samples;
+  double total = 0.0;
+  uint64_t allocations = num_allocations.load();
+
+  for (unsigned i = 0; i < num_samples; i++) {
+    samples.push_back((double) TimeBatch(benchmark, fixtures, batch) / batch);
+    total += samples.back();
+  }
+
+  allocations = num_allocations.load() - allocations;
+  std::sort(samples.begin(), samples.end());
+  Result result;
+  result.name = benchmark.name;
+  result.num_loose = fixtures[0]->num_loose;
+  result.num_builds = fixtures[0]->num_builds;
+  result.num_calls = batch * num_samples;
+  result.mean = total / num_samples;
+  result.p50 = samples[num_samples * 50 / 100];
+  result.p90 = samples[num_samples * 90 / 100];
+  result.p99 = samples[num_samples * 99 / 100];
+  result.allocations = (double) allocations / result.num_calls;
+
+  return result;
+}
+
+/**
+ * Description: Prints the results as CSV, one row per benchmark and density.
+ *     Throughput is calls per second at the median and slowest-percent
+ *     samples.
+ * Parameters: const std::vector<Result>& results: The results.
+ * Returns: Nothing.
+ */
+
+void PrintCsv(const std::vector<Result>& results) {
+  std::cout << "benchmark,loose,builds,calls,ns_mean,ns_p50,ns_p90,ns_p99,"
+            << "allocs_per_call,calls_per_sec_p50,calls_per_sec_p99\n";
+
+  for (unsigned i = 0; i < results.size(); i++) {
+    const Result& result = results[i];
+    std::cout << result.name << ',' << result.num_loose << ','
+              << result.num_builds << ',' << result.num_calls << ','
+              << result.mean << ',' << result.p50 << ',' << result.p90 << ','
+              << result.p99 << ',' << result.allocations << ','
+              << 1e9 / result.p50 << ',' << 1e9 / result.p99 << '\n';
+  }
+}
+
+/**
+ * Description: Prints the results as a JSON array with the CSV's fields.
+ * Parameters: const std::vector<Result>& results: The results.
+ * Returns: Nothing.
+ */
+
+void PrintJson(const std::vector<Result>& results) {
+  std::cout << "[\n";
+
+  for (unsigned i = 0; i < results.size(); i++) {
+    const Result& result = results[i];
+    std::cout << "  {\"benchmark\": \"" << result.name << "\", \"loose\": "
+              << result.num_loose << ", \"builds\": " << result.num_builds
+              << ", \"calls\": " << result.num_calls << ", \"ns_mean\": "
+              << result.mean << ", \"ns_p50\": " << result.p50
+              << ", \"ns_p90\": " << result.p90 << ", \"ns_p99\": "
+              << result.p99 << ", \"allocs_per_call\": " << result.allocations
+              << ", \"calls_per_sec_p50\": " << 1e9 / result.p50
+              << ", \"calls_per_sec_p99\": " << 1e9 / result.p99 << '}'
+              << (i + 1 < results.size() ? ",\n" : "\n");
+  }
+
+  std::cout << "]\n";
+}
+
+}  // namespace
+
+// aibench [--json] [--samples <n>] [--seed <n>] [--filter <name>] times the
+// computer's search routines on fixtures from 4 to 24 loose cards and 0 to 6
+// builds. The fixtures depend only on the seed, so runs on different commits
+// can be diffed row by row.
+int main(int argc, char* argv[]) {
+  bool is_json = false;
+  unsigned num_samples = 50;
+  uint64_t seed = 1;
+  std::string filter;
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--json")) {
+      is_json = true;
+    } else if (!strcmp(argv[i], "--samples") && i + 1 < argc) {
+      num_samples = atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+      seed = strtoull(argv[++i], NULL, 10);
+    } else if (!strcmp(argv[i], "--filter") && i + 1 < argc) {
+      filter = argv[++i];
+    } else {
+      std::cerr << "Unknown argument: " << argv[i] << std::endl;
+      return 1;
+    }
+  }
+
+  if (!num_samples) {
+    std::cerr << "--samples must be positive" << std::endl;
+    return 1;
+  }
+
+  std::vector<Result> results;
+
+  for (const Benchmark& benchmark : kBenchmarks) {
+    if (!filter.empty() && filter != benchmark.name) {
+      continue;
+    }
+
+    for (unsigned num_loose : kLooseCounts) {
+      for (unsigned num_builds : kBuildCounts) {
+        Fixtures fixtures;
+
+        for (unsigned i = 0; i < kNumVariants; i++) {
+          fixtures.push_back(BenchFixture::Create(num_loose, num_builds,
+              Random::GetGameSeed(seed, num_loose * 64 + num_builds * 8 + i)));
+        }
+
+        results.push_back(Run(benchmark, fixtures, num_samples));
+      }
+    }
+  }
+
+  if (is_json) {
+    PrintJson(results);
+  } else {
+    PrintCsv(results);
+  }
+
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include <algorithm>
+#include "benchfixture.h"
+
+/**
+ * Description: Deals a fixture. Builds pair two cards whose values sum to
+ *     at most an ace's high value and alternate between the two owners.
+ * Parameters: const unsigned& num_loose: The number of loose cards.
+ * const unsigned& num_builds: The number of builds.
+ * const uint64_t& seed: The seed of the shuffle.
+ * Returns: The fixture.
+ */
+
+std::shared_ptr<BenchFixture> BenchFixture::Create(
+    const unsigned& num_loose, const unsigned& num_builds,
+    const uint64_t& seed) {
+  Random rng(seed);
+  std::vector<Card> deck;
+
+  for (unsigned id = 0; id < Card::kNumCards; id++) {
+    deck.push_back(Card::FromId(id));
+  }
+
+  for (unsigned i = deck.size(); i > 1; i--) {
+    std::swap(deck[i - 1], deck[rng.NextBelow(i)]);
+  }
+
+  std::shared_ptr<BenchFixture> fixture(new BenchFixture);
+  fixture->player = std::shared_ptr<BenchPlayer>(new BenchPlayer);
+  fixture->player->SetIsVerbose(false);
+  fixture->player->SetHand(
+      std::vector<Card>(deck.begin(), deck.begin() + kHandSize));
+  fixture->table = std::shared_ptr<Table>(new Table);
+  fixture->num_loose = num_loose;
+  fixture->num_builds = num_builds;
+  unsigned next = kHandSize;
+
+  for (unsigned i = 0; i < num_builds && next + 1 < deck.size(); i++) {
+    unsigned pair = next + 1;
+
+    while (pair < deck.size() &&
+        deck[next].GetValue() + deck[pair].GetValue() > Card::kAceTwo) {
+      pair++;
+    }
+
+    if (pair == deck.size()) {
+      break;
+    }
+
+    std::swap(deck[next + 1], deck[pair]);
+    std::shared_ptr<Build> build(new Build);
+    build->AddToBuild(std::vector<Card>(deck.begin() + next,
+        deck.begin() + next + 2));
+    build->SetBuildSum(deck[next].GetValue() + deck[next + 1].GetValue());
+    build->SetOwnerIndex(i % 2);
+    fixture->table->AddBuild(build);
+    next += 2;
+  }
+
+  unsigned last = std::min<unsigned>(next + num_loose, deck.size());
+  fixture->table->SetLooseCards(
+      std::vector<Card>(deck.begin() + next, deck.begin() + last));
+  fixture->value = deck[0].GetValue();
+
+  return fixture;
+}
\ No newline at end of file
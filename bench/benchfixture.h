@@ -0,0 +1,44 @@
+#ifndef _BENCH_FIXTURE_H_
+#define _BENCH_FIXTURE_H_
+
+#include <memory>
+#include <vector>
+#include "player.h"
+#include "random.h"
+
+// A player that opens up the AI's search routines to the benchmarks.
+class BenchPlayer : public Player {
+ public:
+  using Player::FindBestCapture;
+  using Player::FindBestBuild;
+  using Player::FindBestSingleBuild;
+  using Player::FindBestMultiBuild;
+  using Player::FindBestIncreaseBuild;
+  using Player::GetAllValidSets;
+  using Player::GetBestValidSetOfSets;
+
+  // Public utils
+  bool MakeMove(std::shared_ptr<Table>&) { return false; }
+};
+
+// A hand of four and a table with the given number of loose cards and
+// two-card builds, dealt from a deck shuffled by the seed.
+struct BenchFixture {
+  std::shared_ptr<BenchPlayer> player;
+  std::shared_ptr<Table> table;
+  unsigned num_loose;
+  unsigned num_builds;
+
+  // The first hand card's value, for the set finders
+  unsigned value;
+
+  // Public utils
+  static std::shared_ptr<BenchFixture> Create(const unsigned& num_loose,
+      const unsigned& num_builds, const uint64_t& seed);
+
+ private:
+  // Private constants
+  static const unsigned kHandSize = 4;
+};
+
+#endif
\ No newline at end of file
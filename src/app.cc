@@ -1,25 +1,11 @@
+#include <ctime>
 #include "app.h"
 #include "inputhandler.h"
 #include "serializer.h"
 
 /**
- * Description: Sets the player states from a file.
- * Parameters: std::ifstream& in_file: The file stream.
- * Returns: Nothing.
- */
-
-void App::SetPlayerDataFromFile(std::ifstream& in_file) {
-  auto players = tournament_->GetPlayers();
-
-  for (unsigned i = 0; i < players.size(); i++) {
-    players[i]->SetScore(Serializer::GetPlayerScoreFromFile(in_file));
-    players[i]->SetHand(Serializer::GetCardsFromFile(in_file));
-    players[i]->SetPile(Serializer::GetCardsFromFile(in_file));
-  }
-}
-
-/**
- * Description: Starts the app.
+ * Description: Starts the app. With a move log, the tournament's moves are
+ *     logged under the start time as the game id.
  * Parameters: None.
  * Returns: Nothing.
  */
@@ -27,13 +13,20 @@ void App::SetPlayerDataFromFile(std::ifstream& in_file) {
 void App::Start() {
   tournament_ = std::shared_ptr<Tournament>(new Tournament);
 
+  if (move_log_) {
+    tournament_->SetMoveLog(move_log_, time(NULL));
+  }
+
   if (InputHandler::GetLoadChoiceInput() == kLoad) {
-    std::ifstream in_file =
-        Serializer::OpenLoadFile(InputHandler::GetFileInput());
-    tournament_->SetRoundNum(Serializer::GetRoundNumFromFile(in_file));
-    SetPlayerDataFromFile(in_file);
-    tournament_->PlayLoaded(in_file);
-    in_file.close();
+    auto players = tournament_->GetPlayers();
+    unsigned round_num;
+    unsigned next_player;
+    std::shared_ptr<Table> table;
+    std::shared_ptr<Deck> deck;
+    Serializer::LoadRoundState(InputHandler::GetFileInput(), players,
+        round_num, table, deck, next_player);
+    tournament_->SetRoundNum(round_num);
+    tournament_->PlayLoaded(table, deck, next_player);
   } else {
     tournament_->PlayNew();
   }
@@ -13,6 +13,11 @@ class App {
   // Constructor
   App() = default;
 
+  // Mutators
+  inline void SetMoveLog(const std::shared_ptr<MoveLog>& move_log) {
+    move_log_ = move_log;
+  }
+
   // Public utils
   void Start();
 
@@ -24,9 +29,7 @@ class App {
   };
 
   std::shared_ptr<Tournament> tournament_;
-
-  // Private utils
-  void SetPlayerDataFromFile(std::ifstream& in_file);
+  std::shared_ptr<MoveLog> move_log_;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include "arena.h"
+
+const size_t Arena::kBlockSize;
+
+/**
+ * Description: Constructs an arena with one block.
+ * Parameters: None.
+ * Returns: Nothing.
+ */
+
+Arena::Arena() {
+  blocks_.push_back(Block{new char[kBlockSize], kBlockSize});
+  Reset();
+}
+
+/**
+ * Description: Frees every block.
+ * Parameters: None.
+ * Returns: Nothing.
+ */
+
+Arena::~Arena() {
+  for (unsigned i = 0; i < blocks_.size(); i++) {
+    delete[] blocks_[i].data;
+  }
+}
+
+/**
+ * Description: Gets the number of bytes the arena holds.
+ * Parameters: None.
+ * Returns: The capacity.
+ */
+
+size_t Arena::GetCapacity() const {
+  size_t capacity = 0;
+
+  for (unsigned i = 0; i < blocks_.size(); i++) {
+    capacity += blocks_[i].size;
+  }
+
+  return capacity;
+}
+
+/**
+ * Description: Gets the arena of the calling thread.
+ * Parameters: None.
+ * Returns: The arena.
+ */
+
+Arena& Arena::GetThreadArena() {
+  static thread_local Arena arena;
+
+  return arena;
+}
+
+/**
+ * Description: Allocates when the current block is full by moving on to the
+ *     next block that fits, adding one at the end if none does.
+ * Parameters: const size_t& size: The number of bytes.
+ * const size_t& align: The alignment, a power of two.
+ * Returns: The memory.
+ */
+
+void* Arena::AllocateSlow(const size_t& size, const size_t& align) {
+  while (block_ + 1 < blocks_.size()) {
+    Rewind(Mark{block_ + 1, blocks_[block_ + 1].data});
+    char* start = (char*) (((uintptr_t) next_ + align - 1) & ~(align - 1));
+
+    if (start + size <= end_) {
+      next_ = start + size;
+      return start;
+    }
+  }
+
+  size_t block_size = (size + align > kBlockSize ? size + align : kBlockSize);
+  blocks_.push_back(Block{new char[block_size], block_size});
+  Rewind(Mark{(unsigned) blocks_.size() - 1, blocks_.back().data});
+
+  return Allocate(size, align);
+}
\ No newline at end of file
@@ -0,0 +1,152 @@
+#ifndef _ARENA_H_
+#define _ARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// A bump allocator for the scratch data of one move decision. Allocating is
+// a pointer bump, freeing is a no-op, and everything is released at once by
+// rewinding to a mark, which costs the same however much was allocated. The
+// blocks are kept, so once a thread's arena has grown to fit its largest
+// decision it never calls the global allocator again.
+class Arena {
+ public:
+  // Public constants
+  static const size_t kBlockSize = 64 * 1024;
+
+  // Public structs
+  struct Mark {
+    unsigned block;
+    char* next;
+  };
+
+  // Releases everything allocated on the thread's arena while it is alive
+  class Scope {
+   public:
+    Scope(const Scope& scope) = delete;
+    Scope& operator=(const Scope& scope) = delete;
+
+    Scope() : arena_(GetThreadArena()), mark_(arena_.GetMark()) {}
+    ~Scope() { arena_.Rewind(mark_); }
+
+   private:
+    Arena& arena_;
+    Mark mark_;
+  };
+
+  // Delete copy constructor and assignment operator
+  Arena(const Arena& arena) = delete;
+  Arena& operator=(const Arena& arena) = delete;
+
+  // Constructors
+  Arena();
+  ~Arena();
+
+  // Accessors
+  inline Mark GetMark() const { return Mark{block_, next_}; }
+  size_t GetCapacity() const;
+
+  // Public utils
+  inline void* Allocate(const size_t& size, const size_t& align) {
+    char* start = (char*) (((uintptr_t) next_ + align - 1) & ~(align - 1));
+
+    if (start + size > end_) {
+      return AllocateSlow(size, align);
+    }
+
+    next_ = start + size;
+
+    return start;
+  }
+
+  // Only for types with nothing to destroy, since nothing ever is
+  template <class T, class... Args>
+  inline T* New(Args&&... args) {
+    static_assert(std::is_trivially_destructible<T>::value,
+        "arena objects are never destroyed");
+
+    return new (Allocate(sizeof(T), alignof(T)))
+        T(std::forward<Args>(args)...);
+  }
+
+  inline void Rewind(const Mark& mark) {
+    block_ = mark.block;
+    next_ = mark.next;
+    end_ = blocks_[block_].data + blocks_[block_].size;
+  }
+
+  inline void Reset() { Rewind(Mark{0, blocks_[0].data}); }
+  static Arena& GetThreadArena();
+
+ private:
+  // Private structs
+  struct Block {
+    char* data;
+    size_t size;
+  };
+
+  std::vector<Block> blocks_;
+  unsigned block_;
+  char* next_;
+  char* end_;
+
+  // Private utils
+  void* AllocateSlow(const size_t& size, const size_t& align);
+};
+
+// Lets standard containers live on an arena. A default-constructed
+// allocator uses the global heap instead, so a container can be long-lived
+// or scratch with the same type.
+template <class T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+
+  // Constructors
+  ArenaAllocator() : arena_(nullptr) {}
+  ArenaAllocator(Arena* arena) : arena_(arena) {}
+
+  template <class U>
+  ArenaAllocator(const ArenaAllocator<U>& allocator) :
+      arena_(allocator.GetArena()) {}
+
+  // Accessors
+  inline Arena* GetArena() const { return arena_; }
+
+  // Public utils
+  inline T* allocate(const size_t n) {
+    if (arena_) {
+      return (T*) arena_->Allocate(n * sizeof(T), alignof(T));
+    }
+
+    return (T*) ::operator new(n * sizeof(T));
+  }
+
+  inline void deallocate(T* pointer, const size_t) {
+    if (!arena_) {
+      ::operator delete(pointer);
+    }
+  }
+
+  template <class U>
+  inline bool operator==(const ArenaAllocator<U>& allocator) const {
+    return arena_ == allocator.GetArena();
+  }
+
+  template <class U>
+  inline bool operator!=(const ArenaAllocator<U>& allocator) const {
+    return arena_ != allocator.GetArena();
+  }
+
+ private:
+  Arena* arena_;
+};
+
+template <class T>
+using ScratchVector = std::vector<T, ArenaAllocator<T>>;
+
+#endif
\ No newline at end of file
@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include "batchrunner.h"
+#include "computer.h"
+
+/**
+ * Description: Constructs a Computer vs Computer batch runner.
+ * Parameters: const unsigned& num_threads: The number of worker threads.
+ * const uint64_t& seed: The seed of the batch.
+ * Returns: Nothing.
+ */
+
+BatchRunner::BatchRunner(const unsigned& num_threads, const uint64_t& seed) :
+    BatchRunner(num_threads, seed,
+        [] { return std::shared_ptr<Player>(new Computer); },
+        [] { return std::shared_ptr<Player>(new Computer); }) {}
+
+/**
+ * Description: Constructs a batch runner between two policies.
+ * Parameters: const unsigned& num_threads: The number of worker threads.
+ * const uint64_t& seed: The seed of the batch.
+ * const Simulator::PlayerFactory& first: Creates the first player.
+ * const Simulator::PlayerFactory& second: Creates the second player.
+ * Returns: Nothing.
+ */
+
+BatchRunner::BatchRunner(
+    const unsigned& num_threads, const uint64_t& seed,
+    const Simulator::PlayerFactory& first,
+    const Simulator::PlayerFactory& second) :
+    pool_(num_threads), seed_(seed),
+    stats_(new Simulator(first, second)), wall_seconds_(0) {
+  for (unsigned i = 0; i < pool_.GetNumThreads(); i++) {
+    simulators_.push_back(
+        std::shared_ptr<Simulator>(new Simulator(first, second)));
+  }
+}
+
+/**
+ * Description: Logs every move of every game to one shared log.
+ * Parameters: const std::shared_ptr<MoveLog>& move_log: The log.
+ * Returns: Nothing.
+ */
+
+void BatchRunner::SetMoveLog(const std::shared_ptr<MoveLog>& move_log) {
+  for (unsigned i = 0; i < simulators_.size(); i++) {
+    simulators_[i]->SetMoveLog(move_log);
+  }
+}
+
+/**
+ * Description: Plays a batch of games across all the workers. Game i is
+ *     always seeded with Random::GetGameSeed(seed, i), so the results do not
+ *     depend on the number of threads.
+ * Parameters: const unsigned& num_games: The number of games to play.
+ * Returns: Nothing.
+ */
+
+void BatchRunner::Run(const unsigned& num_games) {
+  results_.assign(num_games, Simulator::GameResult());
+  auto start = std::chrono::steady_clock::now();
+
+  for (unsigned first = 0; first < num_games; first += kGamesPerTask) {
+    unsigned last = std::min(first + kGamesPerTask, num_games);
+
+    pool_.Submit([this, first, last] {
+      auto& simulator = simulators_[ThreadPool::GetWorkerIndex()];
+
+      for (unsigned i = first; i < last; i++) {
+        results_[i] = simulator->PlayGame(Random::GetGameSeed(seed_, i));
+      }
+    });
+  }
+
+  pool_.Wait();
+  auto end = std::chrono::steady_clock::now();
+  wall_seconds_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      end - start).count() / 1e9;
+  stats_->ResetStats();
+
+  for (unsigned i = 0; i < simulators_.size(); i++) {
+    stats_->Merge(*simulators_[i]);
+    simulators_[i]->ResetStats();
+  }
+}
+
+/**
+ * Description: Hashes the results in game order. Two runs with the same seed
+ *     and number of games have the same checksum on any number of threads.
+ * Parameters: None.
+ * Returns: The checksum.
+ */
+
+uint64_t BatchRunner::GetChecksum() const {
+  uint64_t checksum = 0xcbf29ce484222325ULL;
+
+  for (unsigned i = 0; i < results_.size(); i++) {
+    const unsigned values[] = {results_[i].scores[0], results_[i].scores[1],
+        results_[i].num_rounds, results_[i].num_moves};
+
+    for (unsigned value : values) {
+      checksum = (checksum ^ value) * 0x100000001b3ULL;
+    }
+  }
+
+  return checksum;
+}
+
+/**
+ * Description: Summarizes the batch as a string.
+ * Parameters: None.
+ * Returns: The summary string.
+ */
+
+std::string BatchRunner::ToString() const {
+  std::ostringstream summary;
+  summary << stats_->ToString()
+          << "Threads: " << pool_.GetNumThreads() << '\n'
+          << "Wall games/sec: "
+          << (wall_seconds_ ? stats_->GetNumGames() / wall_seconds_ : 0.0)
+          << '\n'
+          << "Checksum: " << std::hex << GetChecksum() << std::dec << '\n';
+
+  return summary.str();
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+#ifndef _BATCH_RUNNER_H_
+#define _BATCH_RUNNER_H_
+
+#include "simulator.h"
+#include "threadpool.h"
+
+class BatchRunner {
+ public:
+  // Delete copy constructor and assignment operator
+  BatchRunner(const BatchRunner& batch_runner) = delete;
+  BatchRunner& operator=(const BatchRunner& batch_runner) = delete;
+
+  // Constructors
+  BatchRunner(const unsigned& num_threads, const uint64_t& seed);
+  BatchRunner(const unsigned& num_threads, const uint64_t& seed,
+      const Simulator::PlayerFactory& first,
+      const Simulator::PlayerFactory& second);
+
+  // Accessors
+  inline const Simulator& GetStats() const { return *stats_; }
+  inline const std::vector<Simulator::GameResult>& GetResults() const {
+    return results_;
+  }
+
+  inline unsigned GetNumThreads() const { return pool_.GetNumThreads(); }
+
+  // Mutators
+  void SetMoveLog(const std::shared_ptr<MoveLog>& move_log);
+
+  // Public utils
+  void Run(const unsigned& num_games);
+  uint64_t GetChecksum() const;
+  std::string ToString() const;
+
+ private:
+  // Private constants
+  static const unsigned kGamesPerTask = 16;
+
+  ThreadPool pool_;
+  uint64_t seed_;
+  std::vector<std::shared_ptr<Simulator>> simulators_;
+  std::shared_ptr<Simulator> stats_;
+  std::vector<Simulator::GameResult> results_;
+  double wall_seconds_;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,69 @@
+#ifndef _BITBOARD_H_
+#define _BITBOARD_H_
+
+#include <cstdint>
+#include <vector>
+#include "card.h"
+
+// A set of cards as a 52-bit mask, bit i set when the card with id i is in
+// the set. Spades occupy the lowest 13 bits, then hearts, clubs, diamonds.
+class Bitboard {
+ public:
+  // Public constants
+  static const uint64_t kEmpty = 0;
+  static const uint64_t kAll = (1ULL << Card::kNumCards) - 1;
+  static const uint64_t kSpades = (1ULL << Card::kNumValues) - 1;
+  static const uint64_t kAces = 1ULL | (1ULL << Card::kNumValues) |
+      (1ULL << (2 * Card::kNumValues)) | (1ULL << (3 * Card::kNumValues));
+  static const uint64_t kTenOfDiamonds =
+      1ULL << ((Card::kDiamonds - 1) * Card::kNumValues + Card::kTen - 1);
+  static const uint64_t kTwoOfSpades =
+      1ULL << ((Card::kSpades - 1) * Card::kNumValues + Card::kTwo - 1);
+
+  // Public utils
+  static inline uint64_t FromCard(const Card& card) {
+    return 1ULL << card.GetId();
+  }
+
+  static inline uint64_t FromCards(const std::vector<Card>& cards) {
+    uint64_t mask = kEmpty;
+
+    for (unsigned i = 0; i < cards.size(); i++) {
+      mask |= FromCard(cards[i]);
+    }
+
+    return mask;
+  }
+
+  // All four cards of a value (an ace matches on kAceOne or kAceTwo)
+  static inline uint64_t FromValue(const unsigned& value) {
+    unsigned bit =
+        (value == Card::kAceTwo ? (unsigned) Card::kAceOne : value) - 1;
+
+    return kAces << bit;
+  }
+
+  static inline bool Contains(const uint64_t& mask, const Card& card) {
+    return mask & FromCard(card);
+  }
+
+  static inline unsigned Count(const uint64_t& mask) {
+    return __builtin_popcountll(mask);
+  }
+
+  static inline unsigned CountSpades(const uint64_t& mask) {
+    return Count(mask & kSpades);
+  }
+
+  static inline unsigned CountAces(const uint64_t& mask) {
+    return Count(mask & kAces);
+  }
+
+  // The points the cards are worth in a pile at the end of a round
+  static inline unsigned CountPoints(const uint64_t& mask) {
+    return CountAces(mask) + 2 * Count(mask & kTenOfDiamonds) +
+        Count(mask & kTwoOfSpades);
+  }
+};
+
+#endif
\ No newline at end of file
@@ -5,6 +5,7 @@
  * Due Date: 10/2/18           *
  *******************************/
 
+#include <algorithm>
 #include "build.h"
 
 /**
@@ -16,13 +17,14 @@
 std::string Build::ToString() const {
   std::string build = "[ ";
 
-  for (unsigned i = 0; i < build_.size(); i++) {
+  for (unsigned i = 0; i < num_sets_; i++) {
+    CardView cards = GetBuildAt(i);
     build += '[';
 
-    for (unsigned j = 0; j < build_[i].size(); j++) {
-      build += build_[i][j]->ToString();
+    for (unsigned j = 0; j < cards.size(); j++) {
+      build += cards[j].ToString();
 
-      if (j != build_[i].size() - 1) {
+      if (j != cards.size() - 1) {
         build += ' ';
       }
     }
@@ -32,5 +34,26 @@ std::string Build::ToString() const {
 
   build += "] ";
 
+  return build;
+}
+
+/**
+ * Description: Copies the build, for a search that plays on its own table.
+ * Parameters: None.
+ * Returns: The copy.
+ */
+
+std::shared_ptr<Build> Build::Clone() const {
+  std::shared_ptr<Build> build(new Build);
+  std::copy(cards_, cards_ + num_cards_, build->cards_);
+  std::copy(ends_, ends_ + num_sets_, build->ends_);
+  build->owner_index_ = owner_index_;
+  build->build_sum_ = build_sum_;
+  build->card_hash_ = card_hash_;
+  build->card_mask_ = card_mask_;
+  build->score_ = score_;
+  build->num_cards_ = num_cards_;
+  build->num_sets_ = num_sets_;
+
   return build;
 }
\ No newline at end of file
@@ -11,19 +11,65 @@
 #include <vector>
 #include <memory>
 #include "card.h"
+#include "heuristic.h"
+#include "zobrist.h"
 
+// A build is up to kMaxCards cards kept flat in one array, split into the
+// sets that were built on it. Each card can be in a build only once, so a
+// build never holds more than the deck.
 class Build {
  public:
+  // Public constants
+  static const unsigned kMaxCards = Card::kNumCards;
+
+  // A read-only view of a run of the build's cards
+  class CardView {
+   public:
+    CardView(const Card* begin, const Card* end) : begin_(begin), end_(end) {}
+
+    inline const Card* begin() const { return begin_; }
+    inline const Card* end() const { return end_; }
+    inline const Card* data() const { return begin_; }
+    inline unsigned size() const { return end_ - begin_; }
+    inline bool empty() const { return begin_ == end_; }
+    inline const Card& operator[](const unsigned& index) const {
+      return begin_[index];
+    }
+
+    inline const Card& back() const { return end_[-1]; }
+
+   private:
+    const Card* begin_;
+    const Card* end_;
+  };
+
   // Delete copy constructor and assignment operator
   Build(const Build& build) = delete;
   Build& operator=(const Build& build) = delete;
 
   // Constructors
-  Build() = default;
+  Build() : owner_index_(0), build_sum_(0), card_hash_(0), card_mask_(0),
+      score_(0), num_cards_(0), num_sets_(0) {}
 
   // Accessors
   inline unsigned GetOwnerIndex() const { return owner_index_; }
   inline unsigned GetBuildSum() const { return build_sum_; }
+  inline uint64_t GetHash() const {
+    return Zobrist::Mix((card_hash_ + num_sets_) ^
+        kZobristKeys.build_owner[owner_index_ & 1] ^
+        kZobristKeys.build_sum[build_sum_ & 15]);
+  }
+
+  // Every card in the build, across its sets
+  inline CardView GetCards() const {
+    return CardView(cards_, cards_ + num_cards_);
+  }
+
+  inline unsigned GetNumCards() const { return num_cards_; }
+  inline uint64_t GetCardMask() const { return card_mask_; }
+
+  // The sum of the cards' heuristic values (see heuristic.h)
+  inline unsigned GetScore() const { return score_; }
 
   // Mutators
   inline void SetOwnerIndex(const unsigned& owner_index) {
@@ -35,26 +81,97 @@ class Build {
   }
 
   // Public utils
-  inline void AddToBuild(const std::vector<std::shared_ptr<Card>>& build) {
-    build_.push_back(build);
+  inline void AddToBuild(const std::vector<Card>& build) {
+    for (unsigned i = 0; i < build.size(); i++) {
+      cards_[num_cards_++] = build[i];
+      AddCard(build[i]);
+    }
+
+    ends_[num_sets_++] = num_cards_;
   }
 
-  inline unsigned GetBuildSize() const { return build_.size(); }
-  inline bool IsMultipleBuild() const { return build_.size() > 1; }
-  std::vector<std::shared_ptr<Card>> GetBuildAt(const unsigned& index) const {
-    return build_[index];
+  inline unsigned GetBuildSize() const { return num_sets_; }
+  inline bool IsMultipleBuild() const { return num_sets_ > 1; }
+  inline CardView GetBuildAt(const unsigned& index) const {
+    return CardView(cards_ + (index ? ends_[index - 1] : 0),
+        cards_ + ends_[index]);
   }
 
-  void AddToSingleBuild(const std::shared_ptr<Card>& card) {
-    build_[0].push_back(card);
+  void AddToSingleBuild(const Card& card) {
+    for (unsigned i = num_cards_; i > ends_[0]; i--) {
+      cards_[i] = cards_[i - 1];
+    }
+
+    cards_[ends_[0]] = card;
+    num_cards_++;
+
+    for (unsigned i = 0; i < num_sets_; i++) {
+      ends_[i]++;
+    }
+
+    AddCard(card);
   }
 
+  void RemoveLastBuild() {
+    num_sets_--;
+    unsigned begin = num_sets_ ? ends_[num_sets_ - 1] : 0;
+
+    for (unsigned i = begin; i < num_cards_; i++) {
+      RemoveCard(cards_[i]);
+    }
+
+    num_cards_ = begin;
+  }
+
+  void Clear() {
+    num_cards_ = 0;
+    num_sets_ = 0;
+    card_hash_ = 0;
+    card_mask_ = 0;
+    score_ = 0;
+  }
+
+  void RemoveFromSingleBuild() {
+    RemoveCard(cards_[ends_[0] - 1]);
+
+    for (unsigned i = ends_[0] - 1; i + 1 < num_cards_; i++) {
+      cards_[i] = cards_[i + 1];
+    }
+
+    num_cards_--;
+
+    for (unsigned i = 0; i < num_sets_; i++) {
+      ends_[i]--;
+    }
+  }
+
+  std::shared_ptr<Build> Clone() const;
   std::string ToString() const;
 
  private:
-  std::vector<std::vector<std::shared_ptr<Card>>> build_;
+  Card cards_[kMaxCards];
+  // ends_[i] is one past the last card of set i
+  uint8_t ends_[kMaxCards];
   unsigned owner_index_;
   unsigned build_sum_;
+  uint64_t card_hash_;
+  uint64_t card_mask_;
+  unsigned score_;
+  uint8_t num_cards_;
+  uint8_t num_sets_;
+
+  // Private utils
+  inline void AddCard(const Card& card) {
+    card_hash_ ^= kZobristKeys.build_card[card.GetId()];
+    card_mask_ |= 1ULL << card.GetId();
+    score_ += kHeuristicTable.GetScore(card);
+  }
+
+  inline void RemoveCard(const Card& card) {
+    card_hash_ ^= kZobristKeys.build_card[card.GetId()];
+    card_mask_ &= ~(1ULL << card.GetId());
+    score_ -= kHeuristicTable.GetScore(card);
+  }
 };
 
 #endif
\ No newline at end of file
@@ -1,8 +1,11 @@
 #ifndef _BUILD_NODE_H_
 #define _BUILD_NODE_H_
 
-#include <vector>
+#include <cstdint>
 
+// The best build of one kind for a hand. The loose cards are a mask of their
+// positions on the table (bit i for index i), so nodes hold no heap memory
+// and can live on an Arena.
 class BuildNode {
  public:
   // Public enums
@@ -12,31 +15,25 @@ class BuildNode {
     kIncrease
   };
 
-  // Delete copy constructor and assignment operator
-  BuildNode(const BuildNode& build_node) = delete;
-  BuildNode& operator=(const BuildNode& build_node) = delete;
-
   // Constructors
-  BuildNode() : score_(0) {}
+  BuildNode() : type_(kMake), score_(0), played_card_index_(0),
+      loose_card_mask_(0), build_index_(0) {}
 
   // Accessors
   inline unsigned GetScore() const { return score_; }
   inline unsigned GetPlayedCardIndex() const { return played_card_index_; }
   inline unsigned GetType() const { return type_; }
-  inline std::vector<unsigned> GetLooseCardIndices() const {
-    return loose_card_indices_;
-  }
+  inline uint64_t GetLooseCardMask() const { return loose_card_mask_; }
+  inline unsigned GetBuildIndex() const { return build_index_; }
 
   // Mutators
-  inline unsigned GetBuildIndex() const { return build_index_; }
   inline void SetPlayedCardIndex(const unsigned& played_card_index) {
     played_card_index_ = played_card_index;
   }
 
   inline void SetType(const unsigned& type) { type_ = type; }
-  inline void SetLooseCardIndices(
-      const std::vector<unsigned>& loose_card_indices) {
-    loose_card_indices_ = loose_card_indices;
+  inline void SetLooseCardMask(const uint64_t& loose_card_mask) {
+    loose_card_mask_ = loose_card_mask;
   }
 
   inline void SetBuildIndex(const unsigned& build_index) {
@@ -49,7 +46,7 @@ class BuildNode {
   unsigned type_;
   unsigned score_;
   unsigned played_card_index_;
-  std::vector<unsigned> loose_card_indices_;
+  uint64_t loose_card_mask_;
   unsigned build_index_;
 };
 
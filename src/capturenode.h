@@ -1,30 +1,25 @@
 #ifndef _CAPTURE_NODE_H_
 #define _CAPTURE_NODE_H_
 
-#include <vector>
+#include <cstdint>
 
+// The best capture for a hand. Cards and builds are kept as masks of their
+// positions on the table (bit i for index i), so nodes hold no heap memory
+// and can live on an Arena.
 class CaptureNode {
  public:
-  // Delete copy constructor and assignment operator
-  CaptureNode(const CaptureNode& capture_node) = delete;
-  CaptureNode& operator=(const CaptureNode& capture_node) = delete;
-
   // Constructors
-  CaptureNode() : score_(0) {}
+  CaptureNode() : score_(0), played_card_index_(0), set_mask_(0),
+      loose_card_mask_(0), build_mask_(0) {}
 
   // Accessors
   inline unsigned GetScore() const { return score_; }
   inline unsigned GetPlayedCardIndex() const { return played_card_index_; }
-  inline std::vector<std::vector<unsigned>> GetSetIndices() const {
-    return set_indices_;
-  }
-
-  inline std::vector<unsigned> GetLooseCardIndices() const {
-    return loose_card_indices_;
-  }
-
-  inline std::vector<unsigned> GetBuildIndices() const {
-    return build_indices_;
+  inline uint64_t GetSetMask() const { return set_mask_; }
+  inline uint64_t GetLooseCardMask() const { return loose_card_mask_; }
+  inline uint32_t GetBuildMask() const { return build_mask_; }
+  inline bool IsEmpty() const {
+    return !set_mask_ && !loose_card_mask_ && !build_mask_;
   }
 
   // Mutators
@@ -33,25 +28,21 @@ class CaptureNode {
     played_card_index_ = played_card_index;
   }
 
-  inline void AddSetIndices(const std::vector<unsigned>& set_indices) {
-    set_indices_.push_back(set_indices);
-  }
-
-  inline void SetLooseCardIndices(
-      const std::vector<unsigned>& loose_card_indices) {
-    loose_card_indices_ = loose_card_indices;
+  inline void SetSetMask(const uint64_t& set_mask) { set_mask_ = set_mask; }
+  inline void SetLooseCardMask(const uint64_t& loose_card_mask) {
+    loose_card_mask_ = loose_card_mask;
   }
 
-  inline void SetBuildIndices(const std::vector<unsigned>& build_indices) {
-    build_indices_ = build_indices;
+  inline void SetBuildMask(const uint32_t& build_mask) {
+    build_mask_ = build_mask;
   }
 
  private:
   unsigned score_;
   unsigned played_card_index_;
-  std::vector<std::vector<unsigned>> set_indices_;
-  std::vector<unsigned> loose_card_indices_;
-  std::vector<unsigned> build_indices_;
+  uint64_t set_mask_;
+  uint64_t loose_card_mask_;
+  uint32_t build_mask_;
 };
 
 #endif
\ No newline at end of file
@@ -8,17 +8,15 @@
 #ifndef _CARD_H_
 #define _CARD_H_
 
+#include <cstdint>
 #include <string>
 
 class Card {
  public:
-  // Delete copy constructor and assignment operator
-  Card(const Card& card) = delete;
-  Card& operator=(const Card& card) = delete;
-  
   // Public constants
   static const unsigned kNumSuits = 4;
   static const unsigned kNumValues = 13;
+  static const unsigned kNumCards = kNumSuits * kNumValues;
 
   // Public enums
   enum SuitType {
@@ -45,31 +43,77 @@ class Card {
     kAceTwo
   };
 
-  // Use compiler generated default constructor
-  Card() = default;
+  // Public structs
+  struct Info {
+    uint8_t suit;
+    uint8_t value;
+    bool is_ace;
+    uint8_t points;
+    char symbol[2];
+  };
 
   // Constructors
+  Card() : id_(0) {}
   Card(const std::string& symbols);
-  Card(unsigned suit, unsigned value) : suit_(suit), value_(value),
-      is_ace_(false) {}
+  Card(unsigned suit, unsigned value) :
+      id_((suit - 1) * kNumValues + (value - 1)) {}
 
-  // Accessors
-  inline unsigned GetValue() const { return value_; }
-  inline unsigned GetSuit() const { return suit_; }
-  inline bool IsAce() const { return is_ace_; }
+  static inline Card FromId(const unsigned& id) {
+    Card card;
+    card.id_ = id;
+
+    return card;
+  }
 
-  // Mutators
-  inline void SetValue(const unsigned& value) { value_ = value; }
-  inline void SetSuit(const unsigned& suit) { suit_ = suit; }
-  inline void SetIsAce(const bool& is_ace) { is_ace_ = is_ace; }
+  // Accessors
+  inline unsigned GetId() const { return id_; }
+  inline unsigned GetValue() const;
+  inline unsigned GetSuit() const;
+  inline bool IsAce() const;
+  inline unsigned GetPoints() const;
 
   // Public utils
+  inline bool operator==(const Card& card) const { return id_ == card.id_; }
+  inline bool operator!=(const Card& card) const { return id_ != card.id_; }
   std::string ToString() const;
 
  private:
-  unsigned suit_;
-  unsigned value_;
-  bool is_ace_;
+  // A card is its index into kCardTable: (suit - 1) * kNumValues + value - 1
+  uint8_t id_;
 };
 
+// Everything about the 52 cards, computed at compile time
+struct CardTable {
+  Card::Info cards[Card::kNumCards];
+
+  constexpr CardTable() : cards() {
+    const char suits[] = {'S', 'H', 'C', 'D'};
+    const char values[] =
+        {'A', '2', '3', '4', '5', '6', '7', '8', '9', 'X', 'J', 'Q', 'K'};
+
+    for (unsigned id = 0; id < Card::kNumCards; id++) {
+      cards[id].suit = id / Card::kNumValues + 1;
+      cards[id].value = id % Card::kNumValues + 1;
+      cards[id].is_ace = (cards[id].value == Card::kAceOne);
+      cards[id].points = cards[id].is_ace +
+          2 * (cards[id].suit == Card::kDiamonds &&
+              cards[id].value == Card::kTen) +
+          (cards[id].suit == Card::kSpades && cards[id].value == Card::kTwo);
+      cards[id].symbol[0] = suits[id / Card::kNumValues];
+      cards[id].symbol[1] = values[id % Card::kNumValues];
+    }
+  }
+};
+
+constexpr CardTable kCardTable;
+
+inline unsigned Card::GetValue() const { return kCardTable.cards[id_].value; }
+inline unsigned Card::GetSuit() const { return kCardTable.cards[id_].suit; }
+inline bool Card::IsAce() const { return kCardTable.cards[id_].is_ace; }
+
+// The points the card is worth in a pile at the end of a round
+inline unsigned Card::GetPoints() const {
+  return kCardTable.cards[id_].points;
+}
+
 #endif
\ No newline at end of file
@@ -1,9 +1,164 @@
 #include <cstdlib>
+#include <cstring>
+#include <iostream>
 #include "app.h"
+#include "batchrunner.h"
+#include "gameclient.h"
+#include "movescript.h"
+#include "serializer.h"
+#include "replay.h"
 
-int main() {
+int main(int argc, char* argv[]) {
   srand(time(NULL));
+
+  // casino --simulate <games> [threads] [seed] [first] [second] plays
+  // computers against each other with no input across all cores. A player
+  // is "greedy[:<threads>]" (the default), "search:<millis>[:<threads>]" or
+  // "playouts:<iterations>[:<threads>]". A trailing --log <file> appends
+  // every move of every game to a move log
+  std::shared_ptr<MoveLog> move_log;
+
+  if (argc >= 3 && !strcmp(argv[argc - 2], "--log")) {
+    move_log = std::shared_ptr<MoveLog>(new MoveLog(argv[argc - 1]));
+
+    if (!move_log->IsOpen()) {
+      std::cerr << "Cannot open move log: " << argv[argc - 1] << std::endl;
+      return 1;
+    }
+
+    argc -= 2;
+  }
+
+  if (argc >= 3 && !strcmp(argv[1], "--simulate")) {
+    unsigned num_threads =
+        (argc >= 4 ? atoi(argv[3]) : ThreadPool::GetDefaultNumThreads());
+    uint64_t seed = (argc >= 5 ? strtoull(argv[4], NULL, 10) : time(NULL));
+    Simulator::PlayerFactory factories[2];
+    std::shared_ptr<TranspositionTable> transpositions(new TranspositionTable);
+
+    for (unsigned i = 0; i < 2; i++) {
+      std::string spec = (argc >= 6 + (int) i ? argv[5 + i] : "greedy");
+
+      if (!Simulator::ParsePlayerFactory(
+          spec, transpositions, factories[i])) {
+        std::cerr << "Unknown player: " << spec << std::endl;
+        return 1;
+      }
+    }
+
+    BatchRunner runner(num_threads, seed, factories[0], factories[1]);
+
+    if (move_log) {
+      runner.SetMoveLog(move_log);
+    }
+
+    runner.Run(atoi(argv[2]));
+    std::cout << runner.ToString();
+
+    if (transpositions->GetNumProbes()) {
+      std::cout << "Endgame table: " << transpositions->ToString() << '\n';
+    }
+
+    return 0;
+  }
+
+  // casino --serve <tables> [threads] [seed] [socket] hosts tables on a local
+  // socket and plays them all at once from a loopback client in the same
+  // process, checking every reply against the client's own copy of the table
+  if (argc >= 3 && !strcmp(argv[1], "--serve")) {
+    unsigned num_threads =
+        (argc >= 4 ? atoi(argv[3]) : ThreadPool::GetDefaultNumThreads());
+    uint64_t seed = (argc >= 5 ? strtoull(argv[4], NULL, 10) : time(NULL));
+    std::string socket_path = (argc >= 6 ? argv[5] : "/tmp/casino.sock");
+    GameServer server(socket_path, num_threads);
+
+    if (!server.IsOpen()) {
+      std::cerr << "Cannot listen on " << socket_path << std::endl;
+      return 1;
+    }
+
+    server.Start();
+    GameClient client(socket_path, seed);
+    bool in_step = client.Play(atoi(argv[2]));
+    server.Stop();
+    std::cout << server.ToString() << client.ToString();
+
+    return in_step ? 0 : 1;
+  }
+
+  // casino --make-script <file> <games> [seed] writes a script of human moves
+  // typed at the prompts, and casino --script <file> [threads] plays one back
+  // at full speed, counting the moves whose outcome differs
+  if ((argc == 4 || argc == 5) && !strcmp(argv[1], "--make-script")) {
+    uint64_t seed = (argc == 5 ? strtoull(argv[4], NULL, 10) : time(NULL));
+    MoveScript script;
+    script.Generate(atoi(argv[3]), seed);
+
+    if (!script.Write(argv[2])) {
+      std::cerr << "Cannot write the script to " << argv[2] << std::endl;
+      return 1;
+    }
+
+    return 0;
+  }
+
+  if ((argc == 3 || argc == 4) && !strcmp(argv[1], "--script")) {
+    unsigned num_threads =
+        (argc == 4 ? atoi(argv[3]) : ThreadPool::GetDefaultNumThreads());
+    MoveScript script;
+
+    if (!script.Read(argv[2])) {
+      std::cerr << "Cannot read the script " << argv[2] << std::endl;
+      return 1;
+    }
+
+    script.Run(num_threads);
+    std::cout << script.ToString();
+
+    return script.GetNumDivergences() ? 1 : 0;
+  }
+
+  // casino --replay <log> <game id> [ply] prints a logged headless game as
+  // it stood after the given number of moves (by default, all of them)
+  if ((argc == 4 || argc == 5) && !strcmp(argv[1], "--replay")) {
+    std::vector<Move> moves;
+    std::vector<uint64_t> hashes;
+    uint64_t game_id = strtoull(argv[3], NULL, 10);
+
+    if (!Replay::ReadMoves(argv[2], game_id, moves, hashes)) {
+      std::cerr << "No complete game " << argv[3] << " in " << argv[2]
+                << std::endl;
+      return 1;
+    }
+
+    Replay replay(game_id, moves);
+    replay.SetHashes(hashes);
+    auto round = replay.Seek(argc == 5 ? atoi(argv[4]) : moves.size());
+
+    if (!round) {
+      std::cerr << "The log does not replay to that ply" << std::endl;
+      return 1;
+    }
+
+    std::cout << round->GetRoundData();
+
+    return 0;
+  }
+
+  // casino --convert <in> <out> rewrites a save file in the other format;
+  // the output is binary when its name ends in .bin
+  if (argc == 4 && !strcmp(argv[1], "--convert")) {
+    if (!Serializer::ConvertSaveFile(argv[2], argv[3])) {
+      std::cerr << "Could not convert " << argv[2] << " to " << argv[3]
+                << std::endl;
+      return 1;
+    }
+
+    return 0;
+  }
+
   std::shared_ptr<App> app(new App);
+  app->SetMoveLog(move_log);
   app->Start();
 
   return 0;
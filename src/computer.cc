@@ -2,15 +2,14 @@
 #include "gui.h"
 
 bool Computer::MakeMove(std::shared_ptr<Table>& table) {
-  auto best_capture = FindBestCapture(table);
-  bool can_capture = true;
-
-  if ((best_capture->GetLooseCardIndices().empty()) && 
-      (best_capture->GetBuildIndices().empty()) && 
-      (best_capture->GetSetIndices().empty())) {
-    can_capture = false;
+  if (strength_ == kSearch && SearchMove(table)) {
+    return true;
   }
 
+  Arena::Scope scratch;
+  auto best_capture = FindBestCapture(table);
+  bool can_capture = !best_capture->IsEmpty();
+
   bool can_build = true;
   auto best_build = FindBestBuild(table);
 
@@ -19,23 +18,32 @@ bool Computer::MakeMove(std::shared_ptr<Table>& table) {
   }
 
   if (!can_build && !can_capture) {
-    GUI::DisplayAiTrailOption(hand_[0]);
+    if (is_verbose_) {
+      GUI::DisplayAiTrailOption(hand_[0]);
+    }
+
     TrailAction(0, table);
     return true;
   }
 
   if (!can_build) {
     auto capture_card = hand_[best_capture->GetPlayedCardIndex()];
-    GUI::DisplayAiCaptureOption(best_capture, table, capture_card);
-    Capture(best_capture, table);
+    if (is_verbose_) {
+      GUI::DisplayAiCaptureOption(*best_capture, table, capture_card);
+    }
+
+    Capture(*best_capture, table);
     table->SetLastCapturedIndex(number_);
     return true;
   }
 
   if (!can_capture) {
     auto build_card = hand_[best_build->GetPlayedCardIndex()];
-    GUI::DisplayAiBuildOption(best_build, table, build_card);
-    Build(best_build, table);
+    if (is_verbose_) {
+      GUI::DisplayAiBuildOption(*best_build, table, build_card);
+    }
+
+    Build(*best_build, table);
     return true;
   }
 
@@ -43,61 +51,87 @@ bool Computer::MakeMove(std::shared_ptr<Table>& table) {
   auto build_card = hand_[best_build->GetPlayedCardIndex()];
 
   if (best_capture->GetScore() > best_build->GetScore()) {
-    GUI::DisplayAiCaptureOption(best_capture, table, capture_card);
-    Capture(best_capture, table);
+    if (is_verbose_) {
+      GUI::DisplayAiCaptureOption(*best_capture, table, capture_card);
+    }
+
+    Capture(*best_capture, table);
     table->SetLastCapturedIndex(number_);
     return true;
   }
 
-  GUI::DisplayAiBuildOption(best_build, table, build_card);
-  Build(best_build, table); 
+  if (is_verbose_) {
+    GUI::DisplayAiBuildOption(*best_build, table, build_card);
+  }
+
+  Build(*best_build, table); 
   
   return true;
 }
 
+bool Computer::SearchMove(std::shared_ptr<Table>& table) {
+  auto opponent = opponent_.lock();
+  auto deck = deck_.lock();
+
+  if (!opponent || !deck || hand_.empty()) {
+    return false;
+  }
+
+  uint64_t seed = Random::GetGameSeed(
+      hand_mask_ ^ (pile_mask_ << 1), table->GetLooseMask());
+  MonteCarloSearch search(search_config_);
+  Move move = search.Search(*this, *opponent, table, deck->GetDeckSize(), seed);
+
+  if (is_verbose_) {
+    GUI::DisplayAiSearchOption(move);
+  }
+
+  MoveJournal journal;
+  ApplyMove(move, table, journal);
+
+  return true;
+}
+
 void Computer::Capture(
-    const std::shared_ptr<CaptureNode>& capture_node,
-    std::shared_ptr<Table>& table) {
-  unsigned card_index = capture_node->GetPlayedCardIndex();
-  auto set_indices = capture_node->GetSetIndices();
-  auto loose_cards = table->GetLooseCards();
-
-  for (unsigned i = 0; i < set_indices.size(); i++) {
-    CaptureSetAction(set_indices[i], table);
+    const CaptureNode& capture_node, std::shared_ptr<Table>& table) {
+  unsigned card_index = capture_node.GetPlayedCardIndex();
+
+  if (capture_node.GetSetMask()) {
+    CaptureSetAction(capture_node.GetSetMask(), table);
   }
 
   CaptureAllCardsWithSameValue(card_index, table);
   CaptureAllBuildsWithSameValue(card_index, table);
 
-  pile_.push_back(hand_[card_index]);
+  AddToPile(hand_[card_index]);
   RemoveFromHand(card_index);
 }
 
 void Computer::Build(
-    const std::shared_ptr<BuildNode>& build_node,
-    std::shared_ptr<Table>& table) {
-  unsigned type = build_node->GetType();
-  auto loose_indices = build_node->GetLooseCardIndices();
-  auto builds = table->GetCurrentBuilds();
-  unsigned played_card_index = build_node->GetPlayedCardIndex();
+    const BuildNode& build_node, std::shared_ptr<Table>& table) {
+  unsigned type = build_node.GetType();
+  uint64_t loose_mask = build_node.GetLooseCardMask();
+  const auto& builds = table->GetCurrentBuilds();
+  unsigned played_card_index = build_node.GetPlayedCardIndex();
   auto played_card = hand_[played_card_index];
-  unsigned build_sum = played_card->GetValue();
-  std::vector<std::shared_ptr<Card>> cards;
+  unsigned build_sum = played_card.GetValue();
+  std::vector<Card> cards;
   cards.push_back(played_card);
 
-  for (unsigned index : loose_indices) {
-    cards.push_back(table->GetLooseCard(index));
-    build_sum += table->GetLooseCard(index)->GetValue();
+  for (uint64_t rest = loose_mask; rest; rest &= rest - 1) {
+    Card card = table->GetLooseCard(__builtin_ctzll(rest));
+    cards.push_back(card);
+    build_sum += card.GetValue();
   }
 
   if (type == BuildNode::kMake) {
-    MakeBuildAction(played_card_index, cards, loose_indices, build_sum, table);
+    MakeBuildAction(played_card_index, cards, loose_mask, build_sum, table);
   } else if (type == BuildNode::kAdd) {
-    auto build = builds[build_node->GetBuildIndex()];
-    AddToBuildAction(played_card_index, build, cards, loose_indices, table);
+    auto build = builds[build_node.GetBuildIndex()];
+    AddToBuildAction(played_card_index, build, cards, loose_mask, table);
   } else {
-    auto build = builds[build_node->GetBuildIndex()];
-    IncreaseBuildAction(build_node->GetPlayedCardIndex(), build,
-        build->GetBuildSum() + played_card->GetValue(), table);
+    auto build = builds[build_node.GetBuildIndex()];
+    IncreaseBuildAction(build_node.GetPlayedCardIndex(), build,
+        build->GetBuildSum() + played_card.GetValue(), table);
   }
 }
\ No newline at end of file
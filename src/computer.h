@@ -3,21 +3,49 @@
 
 #include <utility>
 #include "player.h"
+#include "montecarlosearch.h"
 
 class Computer : public Player {
  public:
+  // Public enums
+  enum Strength {
+    kGreedy = 1,
+    kSearch
+  };
+
   // Constructors
-  using Player::Player;
+  Computer() : strength_(kGreedy),
+      search_config_(MonteCarloSearch::kDefaultConfig) {}
+
+  Computer(const unsigned& strength,
+      const MonteCarloSearch::Config& search_config) :
+      strength_(strength), search_config_(search_config) {}
+
+  // Accessors
+  inline unsigned GetStrength() const { return strength_; }
+  inline const MonteCarloSearch::Config& GetSearchConfig() const {
+    return search_config_;
+  }
+
+  // Mutators
+  inline void SetStrength(const unsigned& strength) { strength_ = strength; }
+  inline void SetSearchConfig(const MonteCarloSearch::Config& search_config) {
+    search_config_ = search_config;
+  }
 
   // Public utils
   bool MakeMove(std::shared_ptr<Table>& table);
 
  private:
+  unsigned strength_;
+  MonteCarloSearch::Config search_config_;
+
   // Private utils
-  void Capture(const std::shared_ptr<CaptureNode>& capture_node,
+  bool SearchMove(std::shared_ptr<Table>& table);
+  void Capture(const CaptureNode& capture_node,
       std::shared_ptr<Table>& table);
 
-  void Build(const std::shared_ptr<BuildNode>& build_node,
+  void Build(const BuildNode& build_node,
       std::shared_ptr<Table>& table);
 };
 
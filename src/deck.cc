@@ -5,30 +5,32 @@
  * Due Date: 10/2/18           *
  *******************************/
 
-#include <cmath>
 #include <cstdlib>
 #include "deck.h"
 
 /**
  * Description: Default constructor to initialize a randomly shuffled deck.
+ *     Seeded from the global rand() state.
  * Parameters: None.
  * Returns: Nothing.
  */
 
 Deck::Deck() {
-  for (unsigned suit = 1; suit <= Card::kNumSuits; suit++) {
-    for (unsigned value = 1; value <= Card::kNumValues; value++) {
-      std::shared_ptr<Card> card(new Card(suit, value));
-
-      if (value == Card::kAceOne) {
-        card->SetIsAce(true);
-      }
+  Random rng(rand());
+  Fill();
+  Shuffle(rng);
+}
 
-      deck_.push_back(card);
-    }
-  }
+/**
+ * Description: Constructor to initialize a deck shuffled by a given generator,
+ *     so the same seed always deals the same game.
+ * Parameters: Random& rng: The generator to shuffle with.
+ * Returns: Nothing.
+ */
 
-  Shuffle();
+Deck::Deck(Random& rng) {
+  Fill();
+  Shuffle(rng);
 }
 
 /**
@@ -39,7 +41,7 @@ Deck::Deck() {
 
 Deck::Deck(const std::vector<std::string>& symbols) {
   for (unsigned i = 0; i < symbols.size(); i++) {
-    deck_.push_back(std::shared_ptr<Card>(new Card(symbols[i])));
+    deck_.push_back(Card(symbols[i]));
   }
 }
 
@@ -49,9 +51,10 @@ Deck::Deck(const std::vector<std::string>& symbols) {
  * Returns: A vector of the four most recent cards from the deck.
  */
 
-std::vector<std::shared_ptr<Card>> Deck::DealNext() {
-  std::vector<std::shared_ptr<Card>> return_cards;
+std::vector<Card> Deck::DealNext() {
+  std::vector<Card> return_cards;
   unsigned num_removed = 0;
+  return_cards.reserve(kDealSize);
 
   while ((num_removed++) < kDealSize) {
     return_cards.push_back(deck_.back());
@@ -62,15 +65,32 @@ std::vector<std::shared_ptr<Card>> Deck::DealNext() {
 }
 
 /**
- * Description: Randomly shuffles the deck. std::random_shuffle is depracated.
+ * Description: Fills the deck with all the cards in order.
  * Parameters: None.
  * Returns: Nothing.
  */
 
-void Deck::Shuffle() {
+void Deck::Fill() {
+  deck_.reserve(kMaxDeckSize);
+
+  for (unsigned suit = 1; suit <= Card::kNumSuits; suit++) {
+    for (unsigned value = 1; value <= Card::kNumValues; value++) {
+      deck_.push_back(Card(suit, value));
+    }
+  }
+}
+
+/**
+ * Description: Randomly shuffles the deck (Fisher-Yates). std::random_shuffle
+ *     is depracated.
+ * Parameters: Random& rng: The generator to shuffle with.
+ * Returns: Nothing.
+ */
+
+void Deck::Shuffle(Random& rng) {
   for (unsigned i = kMaxDeckSize - 1; i >= 1; i--) {
-    unsigned random_index = ((i + 1) * ((double) rand() / (RAND_MAX)));
-    std::shared_ptr<Card> temp = deck_[i];
+    unsigned random_index = rng.NextBelow(i + 1);
+    Card temp = deck_[i];
     deck_[i] = deck_[random_index];
     deck_[random_index] = temp;
   }
@@ -86,7 +106,7 @@ std::string Deck::ToString() const {
   std::string deck = "Deck: ";
 
   for (unsigned i = 0; i < deck_.size(); i++) {
-    deck.insert(6, deck_[i]->ToString() + ' ');
+    deck.insert(6, deck_[i].ToString() + ' ');
   }
 
   return deck;
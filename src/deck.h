@@ -11,6 +11,7 @@
 #include <vector>
 #include <memory>
 #include "card.h"
+#include "random.h"
 
 class Deck {
  public:
@@ -23,13 +24,17 @@ class Deck {
   
   // Constructors
   Deck();
-  Deck(std::vector<std::shared_ptr<Card>> deck) : deck_(deck) {}
+  Deck(Random& rng);
+  Deck(std::vector<Card> deck) : deck_(deck) {}
   Deck(const std::vector<std::string>& symbols);
 
+  // Accessors
+  inline const std::vector<Card>& GetCards() const { return deck_; }
+
   // Public utils
   inline unsigned GetDeckSize() const { return deck_.size(); }
   inline bool IsEmpty() const { return deck_.empty(); }
-  std::vector<std::shared_ptr<Card>> DealNext();
+  std::vector<Card> DealNext();
   std::string ToString() const;
 
  private:
@@ -37,8 +42,9 @@ class Deck {
   static const unsigned kDealSize = 4;
 
   // Private utils
-  void Shuffle();
-  std::vector<std::shared_ptr<Card>> deck_;
+  void Fill();
+  void Shuffle(Random& rng);
+  std::vector<Card> deck_;
 };
 
 #endif
\ No newline at end of file
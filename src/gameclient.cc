@@ -0,0 +1,237 @@
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sstream>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "gameclient.h"
+
+const unsigned GameClient::kReadSize;
+
+/**
+ * Description: Connects to a server.
+ * Parameters: const std::string& socket_path: The path of the server's socket.
+ * const uint64_t& seed: The seed of the batch. Table i is seeded with
+ *     Random::GetGameSeed(seed, i).
+ * Returns: Nothing.
+ */
+
+GameClient::GameClient(const std::string& socket_path, const uint64_t& seed) :
+    fd_(socket(AF_UNIX, SOCK_STREAM, 0)), seed_(seed), num_finished_(0),
+    num_moves_(0), num_divergences_(0), wall_seconds_(0) {
+  sockaddr_un address;
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+
+  if (fd_ < 0) {
+    return;
+  }
+
+  if (socket_path.size() >= sizeof(address.sun_path)) {
+    close(fd_);
+    fd_ = -1;
+
+    return;
+  }
+
+  strcpy(address.sun_path, socket_path.c_str());
+
+  if (connect(fd_, (sockaddr*) &address, sizeof(address)) ||
+      fcntl(fd_, F_SETFL, O_NONBLOCK)) {
+    close(fd_);
+    fd_ = -1;
+  }
+}
+
+/**
+ * Description: Disconnects from the server.
+ * Parameters: None.
+ * Returns: Nothing.
+ */
+
+GameClient::~GameClient() {
+  if (fd_ >= 0) {
+    close(fd_);
+  }
+}
+
+/**
+ * Description: Opens the tables all at once and plays every one of them to the
+ *     end, one move in flight per table.
+ * Parameters: const unsigned& num_tables: The number of tables to play.
+ * Returns: Whether every table was finished in step with its mirror.
+ */
+
+bool GameClient::Play(const unsigned& num_tables) {
+  if (!IsOpen()) {
+    return false;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  uint64_t first = tables_.size();
+
+  for (unsigned i = 0; i < num_tables; i++) {
+    uint64_t seed = Random::GetGameSeed(seed_, first + i);
+    std::shared_ptr<MirroredTable> table(
+        new MirroredTable(Random::GetGameSeed(seed, 1)));
+    table->round = GameServer::CreateRound(seed, table->players);
+    tables_.push_back(table);
+
+    GameServer::Request request = GameServer::Request();
+    request.type = GameServer::Request::kOpen;
+    request.table_id = first + i;
+    request.seed = seed;
+    Queue(request);
+  }
+
+  unsigned num_open = num_tables;
+  uint64_t num_divergences = num_divergences_;
+
+  while (num_open) {
+    pollfd fd = {fd_, (short) (POLLIN | (output_.empty() ? 0 : POLLOUT)), 0};
+
+    if (poll(&fd, 1, -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+
+      return false;
+    }
+
+    if (fd.revents & POLLOUT) {
+      ssize_t num_sent = send(fd_, output_.data(), output_.size(),
+          MSG_NOSIGNAL);
+
+      if (num_sent < 0 && errno != EAGAIN) {
+        return false;
+      }
+
+      output_.erase(output_.begin(),
+          output_.begin() + (num_sent > 0 ? num_sent : 0));
+    }
+
+    if (!(fd.revents & (POLLIN | POLLHUP | POLLERR))) {
+      continue;
+    }
+
+    size_t size = input_.size();
+    input_.resize(size + kReadSize);
+    ssize_t num_read = recv(fd_, input_.data() + size, kReadSize, 0);
+    input_.resize(size + (num_read > 0 ? num_read : 0));
+
+    if (!num_read || (num_read < 0 && errno != EAGAIN)) {
+      return false;
+    }
+
+    size_t offset = 0;
+
+    for (; offset + sizeof(GameServer::Reply) <= input_.size();
+         offset += sizeof(GameServer::Reply)) {
+      GameServer::Reply reply;
+      memcpy(&reply, input_.data() + offset, sizeof(reply));
+
+      if (!HandleReply(reply)) {
+        num_open--;
+      }
+    }
+
+    input_.erase(input_.begin(), input_.begin() + offset);
+  }
+
+  wall_seconds_ += std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+
+  return num_divergences_ == num_divergences;
+}
+
+/**
+ * Description: Summarizes the statistics as a string.
+ * Parameters: None.
+ * Returns: The summary string.
+ */
+
+std::string GameClient::ToString() const {
+  std::ostringstream summary;
+  summary << "Client tables: " << num_finished_ << '\n'
+          << "Client moves: " << num_moves_ << '\n'
+          << "Divergences: " << num_divergences_ << '\n'
+          << "Client tables/sec: "
+          << (wall_seconds_ > 0 ? num_finished_ / wall_seconds_ : 0.0) << '\n';
+
+  return summary.str();
+}
+
+/**
+ * Description: Checks a reply against the table's mirror and, while the table
+ *     is open, makes and sends the next move. A reply that does not match
+ *     counts as a divergence and gives up on the table.
+ * Parameters: const GameServer::Reply& reply: The reply.
+ * Returns: Whether a move was sent, so another reply is due.
+ */
+
+bool GameClient::HandleReply(const GameServer::Reply& reply) {
+  if (reply.table_id >= tables_.size()) {
+    num_divergences_++;
+
+    return false;
+  }
+
+  MirroredTable& table = *tables_[reply.table_id];
+  bool is_finished = (reply.status == GameServer::Reply::kFinished);
+
+  if (reply.status == GameServer::Reply::kRejected ||
+      is_finished != table.is_over ||
+      reply.ply != table.round->GetPly() ||
+      reply.hash != table.round->GetHash()) {
+    num_divergences_++;
+
+    return false;
+  }
+
+  if (is_finished) {
+    num_finished_++;
+
+    for (unsigned i = 0; i < 2; i++) {
+      if (reply.scores[i] != table.players[i]->GetScore()) {
+        num_divergences_++;
+        break;
+      }
+    }
+
+    return false;
+  }
+
+  const auto& player = table.round->GetCurrentPlayer();
+  generator_.Generate(player->GetHand(), player->GetNumber(),
+      table.round->GetTable(), moves_);
+  GameServer::Request request = GameServer::Request();
+  request.type = GameServer::Request::kMove;
+  request.table_id = reply.table_id;
+  request.move = moves_[table.rng.NextBelow(moves_.GetSize())];
+  Queue(request);
+
+  table.round->ReplayMove(request.move, table.journal);
+  table.journal.Clear();
+  num_moves_++;
+
+  if (!table.round->PrepareMove()) {
+    table.round->Step(Round::kAdvance);
+    table.is_over = true;
+  }
+
+  return true;
+}
+
+/**
+ * Description: Queues a request to be sent.
+ * Parameters: const GameServer::Request& request: The request.
+ * Returns: Nothing.
+ */
+
+void GameClient::Queue(const GameServer::Request& request) {
+  const uint8_t* bytes = (const uint8_t*) &request;
+  output_.insert(output_.end(), bytes, bytes + sizeof(request));
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#ifndef _GAME_CLIENT_H_
+#define _GAME_CLIENT_H_
+
+#include "gameserver.h"
+#include "movegenerator.h"
+#include "random.h"
+
+// Plays many tables on a GameServer at once over its socket, to load it and
+// to check it. Every table is mirrored by a local round from the same seed:
+// the client picks a random legal move, makes it locally as well, and expects
+// the server to reply with the same hash.
+class GameClient {
+ public:
+  // Delete copy constructor and assignment operator
+  GameClient(const GameClient& game_client) = delete;
+  GameClient& operator=(const GameClient& game_client) = delete;
+
+  // Constructors
+  GameClient(const std::string& socket_path, const uint64_t& seed);
+  ~GameClient();
+
+  // Accessors
+  inline bool IsOpen() const { return fd_ >= 0; }
+  inline uint64_t GetNumDivergences() const { return num_divergences_; }
+
+  // Public utils
+  bool Play(const unsigned& num_tables);
+  std::string ToString() const;
+
+ private:
+  // Private structs
+  struct MirroredTable {
+    MirroredTable(const uint64_t& seed) : rng(seed), is_over(false) {}
+
+    std::vector<std::shared_ptr<Player>> players;
+    std::shared_ptr<Round> round;
+    MoveJournal journal;
+    Random rng;
+    bool is_over;
+  };
+
+  // Private constants
+  static const unsigned kReadSize = 64 * 1024;
+
+  int fd_;
+  uint64_t seed_;
+  std::vector<std::shared_ptr<MirroredTable>> tables_;
+  std::vector<uint8_t> input_;
+  std::vector<uint8_t> output_;
+  MoveGenerator generator_;
+  MoveList moves_;
+  uint64_t num_finished_;
+  uint64_t num_moves_;
+  uint64_t num_divergences_;
+  double wall_seconds_;
+
+  // Private utils
+  bool HandleReply(const GameServer::Reply& reply);
+  void Queue(const GameServer::Request& request);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,557 @@
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sstream>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "gameserver.h"
+#include "computer.h"
+
+static_assert(sizeof(GameServer::Request) == 32, "requests are 32 bytes");
+static_assert(sizeof(GameServer::Reply) == 24, "replies are 24 bytes");
+
+const unsigned GameServer::kReadSize;
+const unsigned GameServer::kMaxOutputSize;
+const int GameServer::kBacklog;
+
+/**
+ * Description: Listens on a Unix domain socket, replacing any file left at
+ *     its path. Nothing is served until Start is called.
+ * Parameters: const std::string& socket_path: The path of the socket.
+ * const unsigned& num_threads: The number of threads to play the tables on.
+ * Returns: Nothing.
+ */
+
+GameServer::GameServer(
+    const std::string& socket_path, const unsigned& num_threads) :
+    socket_path_(socket_path), listen_fd_(-1), wake_fds_{-1, -1},
+    pool_(num_threads), stopping_(false), move_latency_(num_threads),
+    num_finished_(0), num_moves_(0), num_rejected_(0) {
+  sockaddr_un address;
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+
+  if (socket_path.size() >= sizeof(address.sun_path) ||
+      pipe2(wake_fds_, O_NONBLOCK)) {
+    return;
+  }
+
+  strcpy(address.sun_path, socket_path.c_str());
+  unlink(socket_path.c_str());
+  listen_fd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+
+  if (listen_fd_ >= 0 &&
+      (bind(listen_fd_, (sockaddr*) &address, sizeof(address)) ||
+       listen(listen_fd_, kBacklog))) {
+    close(listen_fd_);
+    listen_fd_ = -1;
+  }
+}
+
+/**
+ * Description: Stops serving and removes the socket.
+ * Parameters: None.
+ * Returns: Nothing.
+ */
+
+GameServer::~GameServer() {
+  Stop();
+
+  for (unsigned i = 0; i < 2; i++) {
+    if (wake_fds_[i] >= 0) {
+      close(wake_fds_[i]);
+    }
+  }
+
+  if (listen_fd_ >= 0) {
+    close(listen_fd_);
+    unlink(socket_path_.c_str());
+  }
+}
+
+/**
+ * Description: Starts accepting connections and serving their tables.
+ * Parameters: None.
+ * Returns: Nothing.
+ */
+
+void GameServer::Start() {
+  if (!IsOpen() || poll_thread_.joinable()) {
+    return;
+  }
+
+  start_ = std::chrono::steady_clock::now();
+  poll_thread_ = std::thread(&GameServer::Poll, this);
+}
+
+/**
+ * Description: Stops polling, lets the moves already handed to the pool
+ *     finish, and drops every connection.
+ * Parameters: None.
+ * Returns: Nothing.
+ */
+
+void GameServer::Stop() {
+  if (!poll_thread_.joinable()) {
+    return;
+  }
+
+  stopping_ = true;
+  Wake();
+  poll_thread_.join();
+  pool_.Wait();
+  stop_ = std::chrono::steady_clock::now();
+
+  for (unsigned i = 0; i < connections_.size(); i++) {
+    close(connections_[i].first->fd);
+  }
+
+  connections_.clear();
+}
+
+/**
+ * Description: Gets how many tables were played to the end per second, from
+ *     Start until Stop (or until now, if still serving).
+ * Parameters: None.
+ * Returns: The tables finished per second.
+ */
+
+double GameServer::GetTablesPerSecond() const {
+  auto end = (stopping_ ? stop_ : std::chrono::steady_clock::now());
+  double seconds = std::chrono::duration<double>(end - start_).count();
+
+  return seconds > 0 ? num_finished_ / seconds : 0.0;
+}
+
+/**
+ * Description: Merges the latencies of every worker, from a message being read
+ *     to its reply being queued. Only call it once the server is stopped.
+ * Parameters: None.
+ * Returns: The merged latencies.
+ */
+
+LatencyHistogram GameServer::GetMoveLatency() const {
+  LatencyHistogram merged;
+
+  for (unsigned i = 0; i < move_latency_.size(); i++) {
+    merged.Merge(move_latency_[i]);
+  }
+
+  return merged;
+}
+
+/**
+ * Description: Summarizes the statistics as a string.
+ * Parameters: None.
+ * Returns: The summary string.
+ */
+
+std::string GameServer::ToString() const {
+  std::ostringstream summary;
+  summary << "Tables finished: " << num_finished_ << '\n'
+          << "Moves: " << num_moves_ << '\n'
+          << "Rejected: " << num_rejected_ << '\n'
+          << "Tables/sec: " << GetTablesPerSecond() << '\n'
+          << "Move latency: " << GetMoveLatency().ToString() << '\n';
+
+  return summary.str();
+}
+
+/**
+ * Description: Sets up a round from a seed: the coin toss for the first
+ *     player, then the deck, as in Tournament::PlayHeadless.
+ * Parameters: const uint64_t& seed: The seed of the table.
+ * std::vector<std::shared_ptr<Player>>& players: An input parameter filled
+ *     out with the two computer players. The round plays on them, so it must
+ *     not outlive the vector.
+ * Returns: The round, dealt and ready for its first move.
+ */
+
+std::shared_ptr<Round> GameServer::CreateRound(
+    const uint64_t& seed, std::vector<std::shared_ptr<Player>>& players) {
+  Random rng(seed);
+  unsigned first_player = rng.NextBelow(2);
+  players.clear();
+
+  for (unsigned i = 0; i < 2; i++) {
+    players.push_back(std::shared_ptr<Player>(new Computer));
+    players[i]->SetIsHuman(false);
+    players[i]->SetIsVerbose(false);
+    players[i]->SetNumber(i);
+    players[i]->SetIsTurn(i == first_player);
+  }
+
+  std::shared_ptr<Deck> deck(new Deck(rng));
+
+  return std::shared_ptr<Round>(new Round(players, deck, 1));
+}
+
+/**
+ * Description: Runs on the poll thread. Waits for new connections, incoming
+ *     messages, replies to send and the call to stop.
+ * Parameters: None.
+ * Returns: Nothing.
+ */
+
+void GameServer::Poll() {
+  std::vector<pollfd> fds;
+
+  while (!stopping_) {
+    fds.assign(
+        {pollfd{listen_fd_, POLLIN, 0}, pollfd{wake_fds_[0], POLLIN, 0}});
+
+    for (unsigned i = 0; i < connections_.size(); i++) {
+      Connection& connection = *connections_[i].first;
+      std::lock_guard<std::mutex> lock(connection.output_mutex);
+      short events = POLLIN | (connection.output.empty() ? 0 : POLLOUT);
+      fds.push_back(pollfd{connection.fd, events, 0});
+    }
+
+    if (poll(fds.data(), fds.size(), -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+
+      break;
+    }
+
+    if (fds[1].revents & POLLIN) {
+      uint8_t buffer[256];
+
+      while (read(wake_fds_[0], buffer, sizeof(buffer)) > 0) {}
+    }
+
+    for (unsigned i = connections_.size(); i-- > 0;) {
+      short revents = fds[i + 2].revents;
+      const auto& connection = connections_[i].first;
+
+      if ((revents & (POLLIN | POLLHUP | POLLERR) &&
+           !Read(connection, connections_[i].second)) ||
+          (revents & POLLOUT && !Flush(*connection)) ||
+          !Sweep(*connection, connections_[i].second)) {
+        close(connection->fd);
+        connections_.erase(connections_.begin() + i);
+      }
+    }
+
+    if (fds[0].revents & POLLIN) {
+      Accept();
+    }
+  }
+}
+
+/**
+ * Description: Accepts every connection waiting on the socket.
+ * Parameters: None.
+ * Returns: Nothing.
+ */
+
+void GameServer::Accept() {
+  while (true) {
+    int fd = accept4(listen_fd_, NULL, NULL, SOCK_NONBLOCK);
+
+    if (fd < 0) {
+      return;
+    }
+
+    std::shared_ptr<Connection> connection(new Connection);
+    connection->fd = fd;
+    connection->is_stalled = false;
+    connections_.push_back(std::make_pair(connection, TableMap()));
+  }
+}
+
+/**
+ * Description: Reads what has arrived on a connection and posts every whole
+ *     request in it.
+ * Parameters: const std::shared_ptr<Connection>& connection: The connection.
+ * TableMap& tables: The connection's tables.
+ * Returns: Whether the connection is still open.
+ */
+
+bool GameServer::Read(
+    const std::shared_ptr<Connection>& connection, TableMap& tables) {
+  auto& input = connection->input;
+  size_t size = input.size();
+  input.resize(size + kReadSize);
+  ssize_t num_read = recv(connection->fd, input.data() + size, kReadSize, 0);
+  input.resize(size + (num_read > 0 ? num_read : 0));
+
+  if (num_read <= 0) {
+    return num_read < 0 && (errno == EAGAIN || errno == EINTR);
+  }
+
+  size_t offset = 0;
+
+  for (; offset + sizeof(Request) <= input.size();
+       offset += sizeof(Request)) {
+    Request request;
+    memcpy(&request, input.data() + offset, sizeof(request));
+    Post(tables, connection, request);
+  }
+
+  input.erase(input.begin(), input.begin() + offset);
+
+  return true;
+}
+
+/**
+ * Description: Sends as much of a connection's queued replies as the socket
+ *     takes without blocking.
+ * Parameters: Connection& connection: The connection.
+ * Returns: Whether the connection is still open.
+ */
+
+bool GameServer::Flush(Connection& connection) {
+  std::lock_guard<std::mutex> lock(connection.output_mutex);
+  auto& output = connection.output;
+  ssize_t num_sent =
+      send(connection.fd, output.data(), output.size(), MSG_NOSIGNAL);
+
+  if (num_sent < 0) {
+    return errno == EAGAIN || errno == EINTR;
+  }
+
+  output.erase(output.begin(), output.begin() + num_sent);
+
+  return true;
+}
+
+/**
+ * Description: Forgets the tables of a connection that finished and have not
+ *     been opened again since.
+ * Parameters: Connection& connection: The connection.
+ * TableMap& tables: The connection's tables.
+ * Returns: Whether the connection is still open. It is not once its client
+ *     has stopped reading.
+ */
+
+bool GameServer::Sweep(Connection& connection, TableMap& tables) {
+  std::vector<uint32_t> finished;
+
+  {
+    std::lock_guard<std::mutex> lock(connection.output_mutex);
+
+    if (connection.is_stalled) {
+      return false;
+    }
+
+    finished.swap(connection.finished);
+  }
+
+  for (uint32_t table_id : finished) {
+    auto found = tables.find(table_id);
+    bool is_idle = false;
+
+    if (found == tables.end()) {
+      continue;
+    }
+
+    {
+      HostedTable& table = *found->second;
+      std::lock_guard<std::mutex> lock(table.mutex);
+      is_idle = !table.is_scheduled && !table.round;
+    }
+
+    if (is_idle) {
+      tables.erase(found);
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Description: Puts a request in its table's inbox, opening the table first
+ *     if need be, and queues the table on the pool unless it already is.
+ *     A move for a table that was never opened is rejected right away.
+ * Parameters: TableMap& tables: The connection's tables.
+ * const std::shared_ptr<Connection>& connection: The connection it came on.
+ * const Request& request: The request.
+ * Returns: Nothing.
+ */
+
+void GameServer::Post(
+    TableMap& tables, const std::shared_ptr<Connection>& connection,
+    const Request& request) {
+  auto received = std::chrono::steady_clock::now();
+  auto found = tables.find(request.table_id);
+
+  if (found == tables.end()) {
+    if (request.type != Request::kOpen) {
+      Reply reply = Reply();
+      reply.status = Reply::kRejected;
+      reply.table_id = request.table_id;
+      num_rejected_++;
+      Send(*connection, reply);
+
+      return;
+    }
+
+    std::shared_ptr<HostedTable> table(new HostedTable);
+    table->id = request.table_id;
+    table->is_scheduled = false;
+    table->connection = connection;
+    found = tables.insert(std::make_pair(request.table_id, table)).first;
+  }
+
+  std::shared_ptr<HostedTable> table = found->second;
+  bool schedule = false;
+
+  {
+    std::lock_guard<std::mutex> lock(table->mutex);
+    table->inbox.push_back(Event{request, received});
+    schedule = !table->is_scheduled;
+    table->is_scheduled = true;
+  }
+
+  if (schedule) {
+    pool_.Submit([this, table] { Drain(table); });
+  }
+}
+
+/**
+ * Description: Runs on the pool. Handles a table's requests in the order they
+ *     came until its inbox is empty, then tells the poll thread if the table
+ *     has no round left to play.
+ * Parameters: const std::shared_ptr<HostedTable>& table: The table.
+ * Returns: Nothing.
+ */
+
+void GameServer::Drain(const std::shared_ptr<HostedTable>& table) {
+  LatencyHistogram& move_latency =
+      move_latency_[ThreadPool::GetWorkerIndex()];
+  std::unique_lock<std::mutex> lock(table->mutex);
+
+  while (!table->inbox.empty()) {
+    Event event = table->inbox.front();
+    table->inbox.pop_front();
+    lock.unlock();
+
+    Send(*table->connection, Handle(*table, event.request));
+    move_latency.Record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - event.received).count());
+
+    lock.lock();
+  }
+
+  table->is_scheduled = false;
+  bool is_finished = !table->round;
+  lock.unlock();
+
+  if (is_finished) {
+    Connection& connection = *table->connection;
+
+    {
+      std::lock_guard<std::mutex> output_lock(connection.output_mutex);
+      connection.finished.push_back(table->id);
+    }
+
+    Wake();
+  }
+}
+
+/**
+ * Description: Opens a table or checks a move against the legal moves of the
+ *     player to move and makes it. The round is finished and dropped once no
+ *     moves are left, and the poll thread then forgets the table.
+ * Parameters: HostedTable& table: The table.
+ * const Request& request: The request.
+ * Returns: The reply.
+ */
+
+GameServer::Reply GameServer::Handle(
+    HostedTable& table, const Request& request) {
+  Reply reply = Reply();
+  reply.table_id = request.table_id;
+  reply.status = Reply::kRejected;
+
+  if (request.type == Request::kOpen && !table.round) {
+    table.round = CreateRound(request.seed, table.players);
+    reply.status = Reply::kOpened;
+  } else if (request.type == Request::kMove && table.round &&
+      table.round->ReplayMove(request.move, table.journal)) {
+    table.journal.Clear();
+    reply.status = Reply::kAccepted;
+    num_moves_++;
+  }
+
+  if (reply.status == Reply::kRejected) {
+    num_rejected_++;
+  }
+
+  if (!table.round) {
+    return reply;
+  }
+
+  if (reply.status == Reply::kAccepted && !table.round->PrepareMove()) {
+    table.round->Step(Round::kAdvance);
+    reply.status = Reply::kFinished;
+
+    for (unsigned i = 0; i < 2; i++) {
+      reply.scores[i] = table.players[i]->GetScore();
+    }
+  }
+
+  reply.ply = table.round->GetPly();
+  reply.hash = table.round->GetHash();
+
+  if (reply.status == Reply::kFinished) {
+    table.round.reset();
+    num_finished_++;
+  }
+
+  return reply;
+}
+
+/**
+ * Description: Queues a reply on its connection and wakes the poll thread if
+ *     nothing was queued before. Once kMaxOutputSize bytes are waiting, the
+ *     client is taken to have stopped reading: the reply is dropped and the
+ *     poll thread woken to close the connection.
+ * Parameters: Connection& connection: The connection.
+ * const Reply& reply: The reply.
+ * Returns: Nothing.
+ */
+
+void GameServer::Send(Connection& connection, const Reply& reply) {
+  bool wake;
+
+  {
+    std::lock_guard<std::mutex> lock(connection.output_mutex);
+    auto& output = connection.output;
+
+    if (connection.is_stalled) {
+      return;
+    }
+
+    if (output.size() + sizeof(reply) > kMaxOutputSize) {
+      connection.is_stalled = true;
+      wake = true;
+    } else {
+      wake = output.empty();
+      const uint8_t* bytes = (const uint8_t*) &reply;
+      output.insert(output.end(), bytes, bytes + sizeof(reply));
+    }
+  }
+
+  if (wake) {
+    Wake();
+  }
+}
+
+/**
+ * Description: Wakes the poll thread.
+ * Parameters: None.
+ * Returns: Nothing.
+ */
+
+void GameServer::Wake() {
+  uint8_t byte = 1;
+
+  if (write(wake_fds_[1], &byte, 1) < 0) {
+    return;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,152 @@
+#ifndef _GAME_SERVER_H_
+#define _GAME_SERVER_H_
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "round.h"
+#include "threadpool.h"
+
+// Hosts many tables at once, each a Round that only moves when a message for
+// it arrives. One thread polls a Unix domain socket and hands every message to
+// its table's inbox; a table with mail is queued once on a small thread pool,
+// which drains the inbox and queues the replies back to the poll thread. A
+// table is never worked on by two threads at a time, so no table needs more
+// than its own mutex. The poll thread forgets a table once it has finished,
+// and drops a client that lets too many replies pile up unread.
+class GameServer {
+ public:
+  // Public structs
+  // What a client sends. Tables are numbered by the client, per connection
+  struct Request {
+    // Public enums
+    enum Type {
+      kOpen = 1,
+      kMove
+    };
+
+    uint8_t type;
+    uint8_t reserved[3];
+    uint32_t table_id;
+    uint64_t seed;
+    Move move;
+  };
+
+  // What the server sends back for each request
+  struct Reply {
+    // Public enums
+    enum Status {
+      kOpened = 1,
+      kAccepted,
+      kRejected,
+      kFinished
+    };
+
+    uint8_t status;
+    uint8_t reserved[3];
+    uint32_t table_id;
+    uint32_t ply;
+    uint16_t scores[2];
+    uint64_t hash;
+  };
+
+  // Delete copy constructor and assignment operator
+  GameServer(const GameServer& game_server) = delete;
+  GameServer& operator=(const GameServer& game_server) = delete;
+
+  // Constructors
+  GameServer(const std::string& socket_path, const unsigned& num_threads);
+  ~GameServer();
+
+  // Accessors
+  inline bool IsOpen() const { return listen_fd_ >= 0; }
+  inline unsigned GetNumThreads() const { return pool_.GetNumThreads(); }
+  inline uint64_t GetNumTablesFinished() const { return num_finished_; }
+  inline uint64_t GetNumMoves() const { return num_moves_; }
+  inline uint64_t GetNumRejected() const { return num_rejected_; }
+
+  // Public utils
+  void Start();
+  void Stop();
+  double GetTablesPerSecond() const;
+  LatencyHistogram GetMoveLatency() const;
+  std::string ToString() const;
+
+  // Sets up a round the same way on the server and on any client that mirrors
+  // it: the seed gives the coin toss and then the deck
+  static std::shared_ptr<Round> CreateRound(const uint64_t& seed,
+      std::vector<std::shared_ptr<Player>>& players);
+
+ private:
+  // Private structs
+  struct Connection {
+    int fd;
+    std::vector<uint8_t> input;
+    std::mutex output_mutex;
+    std::vector<uint8_t> output;
+
+    // Tables left without a round since the poll thread last looked, and
+    // whether replies were dropped because the client stopped reading them
+    std::vector<uint32_t> finished;
+    bool is_stalled;
+  };
+
+  struct Event {
+    Request request;
+    std::chrono::steady_clock::time_point received;
+  };
+
+  struct HostedTable {
+    uint32_t id;
+    std::mutex mutex;
+    std::deque<Event> inbox;
+    bool is_scheduled;
+    std::shared_ptr<Connection> connection;
+    std::vector<std::shared_ptr<Player>> players;
+    std::shared_ptr<Round> round;
+    MoveJournal journal;
+  };
+
+  // Every table a connection has opened, by id. Only the poll thread uses it
+  using TableMap = std::unordered_map<uint32_t, std::shared_ptr<HostedTable>>;
+
+  // Private constants
+  static const unsigned kReadSize = 64 * 1024;
+  static const unsigned kMaxOutputSize = 1024 * 1024;
+  static const int kBacklog = 64;
+
+  std::string socket_path_;
+  int listen_fd_;
+  int wake_fds_[2];
+  ThreadPool pool_;
+  std::thread poll_thread_;
+  std::atomic<bool> stopping_;
+  std::vector<std::pair<std::shared_ptr<Connection>, TableMap>> connections_;
+  std::vector<LatencyHistogram> move_latency_;
+  std::atomic<uint64_t> num_finished_;
+  std::atomic<uint64_t> num_moves_;
+  std::atomic<uint64_t> num_rejected_;
+  std::chrono::steady_clock::time_point start_;
+  std::chrono::steady_clock::time_point stop_;
+
+  // Private utils
+  void Poll();
+  void Accept();
+  bool Read(const std::shared_ptr<Connection>& connection, TableMap& tables);
+  bool Flush(Connection& connection);
+  bool Sweep(Connection& connection, TableMap& tables);
+  void Post(TableMap& tables, const std::shared_ptr<Connection>& connection,
+      const Request& request);
+  void Drain(const std::shared_ptr<HostedTable>& table);
+  Reply Handle(HostedTable& table, const Request& request);
+  void Send(Connection& connection, const Reply& reply);
+  void Wake();
+};
+
+#endif
\ No newline at end of file
@@ -6,6 +6,10 @@
  *******************************/
 
 #include "gui.h"
+#include "round.h"
+
+thread_local OutputSink* GUI::sink_ = nullptr;
+ConsoleOutput GUI::console_;
 
 /**
  * Description: Displays the main menu to the player.
@@ -14,11 +18,11 @@
  */
 
 void GUI::DisplayMenu() {
-  std::cout << std::endl;
-  std::cout << "1. Save the game" << std::endl;
-  std::cout << "2. Make a move" << std::endl;
-  std::cout << "3. Ask for help (only before human player plays)" << std::endl;
-  std::cout << "4. Quit the game" << std::endl;
+  GetStream() << '\n';
+  GetStream() << "1. Save the game" << '\n';
+  GetStream() << "2. Make a move" << '\n';
+  GetStream() << "3. Ask for help (only before human player plays)" << '\n';
+  GetStream() << "4. Quit the game" << '\n';
 }
 
 /**
@@ -28,14 +32,14 @@ void GUI::DisplayMenu() {
  */
 
 void GUI::DisplayActionMenu() {
-  std::cout << "1. Build" << std::endl;
-  std::cout << "2. Capture" << std::endl;
-  std::cout << "3. Trail" << std::endl;
+  GetStream() << "1. Build" << '\n';
+  GetStream() << "2. Capture" << '\n';
+  GetStream() << "3. Trail" << '\n';
 }
 
 void GUI::DisplayDeckMenu() {
-  std::cout << "1. Load random deck" << std::endl;
-  std::cout << "2. Load preset deck" << std::endl;
+  GetStream() << "1. Load random deck" << '\n';
+  GetStream() << "2. Load preset deck" << '\n';
 }
 
 /**
@@ -46,15 +50,19 @@ void GUI::DisplayDeckMenu() {
  */
 
 void GUI::DisplayBuildOwners(const std::shared_ptr<Table>& table) {
-  for (unsigned i = 0; i < table->GetCurrentBuilds().size(); i++) {
-    auto build = table->GetCurrentBuilds()[i];
-    std::cout << "Build Owner: " << build->ToString()
-              << (build->GetOwnerIndex() ? "Human" : "Computer")
-              << std::endl;
+  if (IsMuted()) {
+    return;
+  }
+
+  for (unsigned i = 0; i < table->GetNumBuilds(); i++) {
+    const auto& build = table->GetBuild(i);
+    GetStream() << "Build Owner: " << build->ToString()
+                << (build->GetOwnerIndex() ? "Human" : "Computer")
+                << '\n';
   }
 
   if (!table->GetCurrentBuilds().empty()) {
-    std::cout << std::endl;
+    GetStream() << '\n';
   }
 }
 
@@ -66,12 +74,17 @@ void GUI::DisplayBuildOwners(const std::shared_ptr<Table>& table) {
  */
 
 void GUI::DisplayTable(const std::shared_ptr<Table>& table) {
-  std::cout << table->ToString() << std::endl << std::endl;
+  if (IsMuted()) {
+    return;
+  }
+
+  GetStream() << table->ToString() << "\n\n";
   DisplayBuildOwners(table);
 }
 
 /**
- * Description: Displays all info about the players.
+ * Description: Displays all info about the players, with the points each
+ *             would get if the round ended now.
  * Parameters: const std::vector<std::shared_ptr<Player>>& players: The current
  *             state of all players.
  * Returns: Nothing.
@@ -79,8 +92,17 @@ void GUI::DisplayTable(const std::shared_ptr<Table>& table) {
 
 void GUI::DisplayAllPlayerInfo(
     const std::vector<std::shared_ptr<Player>>& players) {
+  if (IsMuted()) {
+    return;
+  }
+
+  PileTally piles[2] = {players[0]->GetPileTally(), players[1]->GetPileTally()};
+  unsigned points[2];
+  Round::ScorePiles(piles, points);
+
   for (unsigned i = 0; i < players.size(); i++) {
-    std::cout << players[i]->ToString() << std::endl;
+    GetStream() << players[i]->ToString() << "\tRound Points: " << points[i]
+                << "\n\n";
   }
 }
 
@@ -91,9 +113,9 @@ void GUI::DisplayAllPlayerInfo(
  */
 
 void GUI::DisplayBuildMenu() {
-  std::cout << "1. Make" << std::endl;
-  std::cout << "2. Add to exisiting build" << std::endl;
-  std::cout << "3. Increase" << std::endl;
+  GetStream() << "1. Make" << '\n';
+  GetStream() << "2. Add to exisiting build" << '\n';
+  GetStream() << "3. Increase" << '\n';
 }
 
 /**
@@ -103,25 +125,29 @@ void GUI::DisplayBuildMenu() {
  */
 
 void GUI::DisplayCaptureMenu() {
-  std::cout << "1. Capture a set" << std::endl;
-  std::cout << "2. Capture a build" << std::endl;
-  std::cout << "3. End turn" << std::endl;
+  GetStream() << "1. Capture a set" << '\n';
+  GetStream() << "2. Capture a build" << '\n';
+  GetStream() << "3. End turn" << '\n';
 }
 
 void GUI::DisplayPlayerPiles(
     const std::vector<std::shared_ptr<Player>>& players) {
+  if (IsMuted()) {
+    return;
+  }
+
   for (unsigned i = 0; i < players.size(); i++) {
-    auto pile = players[i]->GetPile();
-    std::cout << (players[i]->IsHuman() ? "Human pile: " : "Computer pile: ");
+    const auto& pile = players[i]->GetPile();
+    GetStream() << (players[i]->IsHuman() ? "Human pile: " : "Computer pile: ");
 
     for (unsigned j = 0; j < pile.size(); j++) {
-      std::cout << pile[j]->ToString() << ' ';
+      GetStream() << pile[j].ToString() << ' ';
     }
 
-    std::cout << std::endl;
+    GetStream() << '\n';
   }
 
-  std::cout << std::endl;
+  GetStream() << '\n';
 }
 
 /**
@@ -133,6 +159,10 @@ void GUI::DisplayPlayerPiles(
 
 void GUI::DisplayWinningState(
     const std::vector<std::shared_ptr<Player>>& players) {
+  if (IsMuted()) {
+    return;
+  }
+
   bool tie = true;
 
   for (unsigned i = 0; i < players.size() - 1; i++) {
@@ -142,7 +172,7 @@ void GUI::DisplayWinningState(
   }
 
   if (tie) {
-    std::cout << "*** It is a tie ***" << std::endl;
+    GetStream() << "*** It is a tie ***" << '\n';
   } else {
     unsigned max_index = 0;
     unsigned max = 0;
@@ -154,8 +184,8 @@ void GUI::DisplayWinningState(
       }
     }
 
-    std::cout << "*** Player " << max_index + 1 << " wins with a score of "
-        << players[max_index]->GetScore() << "***" << std::endl;
+    GetStream() << "*** Player " << max_index + 1 << " wins with a score of "
+        << players[max_index]->GetScore() << "***" << '\n';
   }
 }
 
@@ -166,111 +196,115 @@ void GUI::DisplayWinningState(
  */
 
 void GUI::DisplayLoadMenu() {
-  std::cout << "1. Load game from file" << std::endl;
-  std::cout << "2. Start new game" << std::endl;
+  GetStream() << "1. Load game from file" << '\n';
+  GetStream() << "2. Start new game" << '\n';
 }
 
 /**
  * Description: Displays the AI's best capture choice.
- * Parameters: const std::shared_ptr<CaptureNode>& capture_node: The best
- *     capture move found.
+ * Parameters: const CaptureNode& capture_node: The best capture move found.
  * const std::shared_ptr<Table>& table: The current table state.
- * const std::shared_ptr<Card>& played_card: The card that was played.
+ * const Card& played_card: The card that was played.
  * Returns: Nothing.
  */
 
 void GUI::DisplayAiCaptureOption(
-    const std::shared_ptr<CaptureNode>& capture_node,
+    const CaptureNode& capture_node,
     const std::shared_ptr<Table>& table,
-    const std::shared_ptr<Card>& played_card) {
-  std::cout <<
+    const Card& played_card) {
+  if (IsMuted()) {
+    return;
+  }
+
+  GetStream() <<
       "The best move is to capture with " <<
-      played_card->ToString() << std::endl;
-  auto loose_cards = table->GetLooseCards();
-  auto builds = table->GetCurrentBuilds();
-  auto loose_indices = capture_node->GetLooseCardIndices();
-  auto build_indices = capture_node->GetBuildIndices();
-  auto set_indices = capture_node->GetSetIndices();
-
-  if (!loose_indices.empty()) {
-    std::cout << "Loose cards to capture: ";
+      played_card.ToString() << '\n';
+  const auto& loose_cards = table->GetLooseCards();
+  const auto& builds = table->GetCurrentBuilds();
+  uint64_t loose_mask = capture_node.GetLooseCardMask();
+  uint32_t build_mask = capture_node.GetBuildMask();
+  uint64_t set_mask = capture_node.GetSetMask();
+
+  if (loose_mask) {
+    GetStream() << "Loose cards to capture: ";
     
-    for (unsigned i = 0; i < loose_indices.size(); i++) {
-      std::cout << loose_cards[loose_indices[i]]->ToString() << ' ';
+    for (uint64_t rest = loose_mask; rest; rest &= rest - 1) {
+      GetStream() << loose_cards[__builtin_ctzll(rest)].ToString() << ' ';
     }
 
-    std::cout << std::endl;
+    GetStream() << '\n';
   }
 
-  if (!build_indices.empty()) {
-    std::cout << "Builds to capture: ";
+  if (build_mask) {
+    GetStream() << "Builds to capture: ";
     
-    for (unsigned i = 0; i < build_indices.size(); i++) {
-      std::cout << builds[build_indices[i]]->ToString() << ' ';
+    for (uint32_t rest = build_mask; rest; rest &= rest - 1) {
+      GetStream() << builds[__builtin_ctz(rest)]->ToString() << ' ';
     }
 
-    std::cout << std::endl;
+    GetStream() << '\n';
   }
 
-  if (!set_indices.empty()) {
-    std::cout << "Sets to capture: ";
+  if (set_mask) {
+    GetStream() << "Sets to capture: ";
     
-    for (unsigned i = 0; i < set_indices.size(); i++) {
-      for (unsigned j = 0; j < set_indices[i].size(); j++) {
-        std::cout << loose_cards[set_indices[i][j]]->ToString() << ' ';
-      }
-
-      std::cout << std::endl;
+    for (uint64_t rest = set_mask; rest; rest &= rest - 1) {
+      GetStream() << loose_cards[__builtin_ctzll(rest)].ToString() << ' ';
     }
+
+    GetStream() << '\n';
   }
 
-  std::cout <<
-      "The score of this move is " << capture_node->GetScore() << std::endl;
+  GetStream() <<
+      "The score of this move is " << capture_node.GetScore() << '\n';
 }
 
 /**
  * Description: Displays the AI's best build choice.
- * Parameters: const std::shared_ptr<BuildNode>& build_node: The best
- *     build move found.
+ * Parameters: const BuildNode& build_node: The best build move found.
  * const std::shared_ptr<Table>& table: The current table state.
- * const std::shared_ptr<Card>& played_card: The card that was played.
+ * const Card& played_card: The card that was played.
  * Returns: Nothing.
  */
 
 void GUI::DisplayAiBuildOption(
-    const std::shared_ptr<BuildNode>& build_node,
+    const BuildNode& build_node,
     const std::shared_ptr<Table>& table,
-    const std::shared_ptr<Card>& played_card) {
-  std::cout <<
+    const Card& played_card) {
+  if (IsMuted()) {
+    return;
+  }
+
+  GetStream() <<
       "The best move is to build with " <<
-      played_card->ToString() << std::endl;
-  unsigned type = build_node->GetType();
-  auto loose_cards = table->GetLooseCards();
-  auto builds = table->GetCurrentBuilds();
-  auto loose_indices = build_node->GetLooseCardIndices();
-  unsigned build_index = build_node->GetBuildIndex();
+      played_card.ToString() << '\n';
+  unsigned type = build_node.GetType();
+  const auto& loose_cards = table->GetLooseCards();
+  const auto& builds = table->GetCurrentBuilds();
+  uint64_t loose_mask = build_node.GetLooseCardMask();
+  unsigned build_index = build_node.GetBuildIndex();
 
   if (type == BuildNode::kMake) {
-    std::cout << "Make a build with ";
+    GetStream() << "Make a build with ";
 
-    for (unsigned i = 0; i < loose_indices.size(); i++) {
-      std::cout << loose_cards[loose_indices[i]]->ToString() << ' ';
+    for (uint64_t rest = loose_mask; rest; rest &= rest - 1) {
+      GetStream() << loose_cards[__builtin_ctzll(rest)].ToString() << ' ';
     }
 
-    std::cout << std::endl;
+    GetStream() << '\n';
   } else if (type == BuildNode::kAdd) {
-    std::cout << "Add to " << builds[build_index]->ToString() << std::endl;
-    std::cout << "Combine played card with ";
+    GetStream() << "Add to " << builds[build_index]->ToString() << '\n';
+    GetStream() << "Combine played card with ";
     
-    for (unsigned i = 0; i < loose_indices.size(); i++) {
-      std::cout << loose_cards[loose_indices[i]]->ToString() << ' ';
+    for (uint64_t rest = loose_mask; rest; rest &= rest - 1) {
+      GetStream() << loose_cards[__builtin_ctzll(rest)].ToString() << ' ';
     }
 
-    std::cout << std::endl;
+    GetStream() << '\n';
   } else {
-    std::cout << "Increase " << builds[build_index]->ToString() << std::endl;
+    GetStream() << "Increase " << builds[build_index]->ToString() << '\n';
   }
 
-  std::cout <<
-      "The score of this move is " << build_node->GetScore() << std::endl;
+  GetStream() <<
+      "The score of this move is " << build_node.GetScore() << '\n';
 }
\ No newline at end of file
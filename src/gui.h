@@ -15,9 +15,22 @@
 #include "deck.h"
 #include "capturenode.h"
 #include "buildnode.h"
+#include "outputsink.h"
 
+// Every message shown to the players. Each thread writes to the console
+// unless given another sink; the messages that have to build their text first
+// skip it when the sink is a null one.
 class GUI {
  public:
+  // Accessors
+  static inline OutputSink& GetSink() { return sink_ ? *sink_ : console_; }
+  static inline std::ostream& GetStream() { return GetSink().GetStream(); }
+  static inline bool IsMuted() { return GetSink().IsNull(); }
+
+  // Mutators
+  // Null for the console
+  static inline void SetSink(OutputSink* sink) { sink_ = sink; }
+
   // Public utils
   static void DisplayMenu();
   static void DisplayActionMenu();
@@ -31,14 +44,14 @@ class GUI {
       const std::vector<std::shared_ptr<Player>>& players);
   
   static void DisplayAiCaptureOption(
-      const std::shared_ptr<CaptureNode>& capture_node,
+      const CaptureNode& capture_node,
       const std::shared_ptr<Table>& table,
-      const std::shared_ptr<Card>& played_card);
+      const Card& played_card);
 
   static void DisplayAiBuildOption(
-      const std::shared_ptr<BuildNode>& build_node,
+      const BuildNode& build_node,
       const std::shared_ptr<Table>& table,
-      const std::shared_ptr<Card>& played_card);
+      const Card& played_card);
 
   static void DisplayPlayerPiles(
       const std::vector<std::shared_ptr<Player>>& players);
@@ -48,175 +61,206 @@ class GUI {
 
   static void DisplayLoadMenu();
   static inline void DisplayCardPlayMessage() {
-    std::cout << "Enter the card you want to play" << std::endl;
+    GetStream() << "Enter the card you want to play" << '\n';
   }
 
   static void DisplayAutomaticCaptureMessage() {
-    std::cout <<
+    GetStream() <<
         "*** Automatically captured cards with the same value as played card ***"
-        << std::endl;
+        << '\n';
   }
 
   static inline void DisplayBuildCardsMessage() {
-    std::cout <<
+    GetStream() <<
         "Enter the cards you want to build with. Enter nothing if only card from hand (only for adding)"
-        << std::endl;
+        << '\n';
   }
 
   static inline void DisplayBuildAddOnMessage() {
-    std::cout << "Enter the cards in the build you want to add to"
-        << std::endl;
+    GetStream() << "Enter the cards in the build you want to add to"
+        << '\n';
   }
 
   static inline void DisplayInvalidChoiceMessage() {
-    std::cout << "*** Not a valid choice ***" << std::endl;
+    GetStream() << "*** Not a valid choice ***" << '\n';
   }
 
   static inline void DisplayCoinMessage() {
-    std::cout << "Toss a coin to see who goes first (0 or 1)" << std::endl;
+    GetStream() << "Toss a coin to see who goes first (0 or 1)" << '\n';
   }
 
   static inline void DisplayTurnSwitchMessage() {
-    std::cout << "*** Switched turns ***" << std::endl;
+    GetStream() << "*** Switched turns ***" << '\n';
   }
 
   static inline void DisplayMustCaptureMessage() {
-    std::cout << "*** Must capture with this card ***" << std::endl;
+    GetStream() << "*** Must capture with this card ***" << '\n';
   }
 
   static inline void DisplayAllHandsEmptyMessage() {
-    std::cout << "*** Dealing because all hands empty ***" << std::endl;
+    GetStream() << "*** Dealing because all hands empty ***" << '\n';
   }
 
   static inline void DisplayPlayerTurnMessage(
       const std::vector<std::shared_ptr<Player>>& players) {
-    std::cout <<
+    if (IsMuted()) {
+      return;
+    }
+
+    GetStream() <<
         (players[0]->IsTurn() ? "Player 1's turn" : "Player 2's turn")
-        << std::endl;
+        << '\n';
   }
 
   static inline void DisplayMustTrailMessage() {
-    std::cout << "*** Must trail because table empty ***" << std::endl;
+    GetStream() << "*** Must trail because table empty ***" << '\n';
   }
 
   static inline void DisplayOwnsBuildMessage() {
-    std::cout << "*** Can't trail if you own build ***" << std::endl;
+    GetStream() << "*** Can't trail if you own build ***" << '\n';
   }
 
   static inline void DisplayAceChoiceMessage( const std::string& card) {
-    std::cout << "Should " << card << " be a (1) or (14)?" << std::endl;
+    GetStream() << "Should " << card << " be a (1) or (14)?" << '\n';
   }
 
   static inline void DisplayCardNotInHandMessage() {
-    std::cout << "*** Card not in hand ***" << std::endl;
+    GetStream() << "*** Card not in hand ***" << '\n';
   }
 
   static inline void DisplayBuildCardsEmptyMessage() {
-    std::cout << "*** Can't make build with no cards ***" << std::endl;
+    GetStream() << "*** Can't make build with no cards ***" << '\n';
   }
 
   static inline void DisplayCardsNotOnTableMessage() {
-    std::cout << "*** Cards not on table *** " << std::endl;
+    GetStream() << "*** Cards not on table *** " << '\n';
   }
 
   static inline void DisplayInvalidCaptureCardMessage() {
-    std::cout << "*** Invalid capture card ***" << std::endl;
+    GetStream() << "*** Invalid capture card ***" << '\n';
   }
 
   static inline void DisplayNoBuildsMessage() {
-    std::cout << "*** No builds on table ***" << std::endl;
+    GetStream() << "*** No builds on table ***" << '\n';
   }
 
   static inline void DisplayNonexistantBuildMessage() {
-    std::cout << "*** Build with those cards doesn't exist ***" << std::endl;
+    GetStream() << "*** Build with those cards doesn't exist ***" << '\n';
   }
 
   static inline void DisplayCannotIncreaseMultiBuildMessage() {
-    std::cout << "*** Cannot increase a multiple build ***" << std::endl;
+    GetStream() << "*** Cannot increase a multiple build ***" << '\n';
   }
 
   static inline void DisplayCannotIncreaseOwnBuildMessage() {
-    std::cout << "*** Cannot increase your own build ***" << std::endl;
+    GetStream() << "*** Cannot increase your own build ***" << '\n';
   }
 
   static inline void DisplayUnequalBuildSumMessage() {
-    std::cout << "*** Not the correct build sum ***" << std::endl;
+    GetStream() << "*** Not the correct build sum ***" << '\n';
   }
 
   static inline void DisplayUnequalCaptureSumMessage() {
-    std::cout << "*** Cards don't add up to the played card ***" << std::endl;
+    GetStream() << "*** Cards don't add up to the played card ***" << '\n';
   }
 
   static inline void DisplayNoCapturesMessage() {
-    std::cout << "*** You haven't captured anything ***" << std::endl;
+    GetStream() << "*** You haven't captured anything ***" << '\n';
   }
 
   static inline void DisplayCaptureSetMessage() {
-    std::cout << "Enter the cards in the set" << std::endl;
+    GetStream() << "Enter the cards in the set" << '\n';
   }
 
   static inline void DisplayMustCaptureBuildMessage() {
-    std::cout << "*** Must capture the build tied to the played card ***"
-        << std::endl;
+    GetStream() << "*** Must capture the build tied to the played card ***"
+        << '\n';
   }
 
   static inline void DisplayPickDifferentCardMessage() {
-    std::cout << "Press 1 to pick a different card, anything else to continue"
-        << std::endl;
+    GetStream() << "Press 1 to pick a different card, anything else to continue"
+        << '\n';
   }
 
   static inline void DisplayCaptureBuildMessage() {
-    std::cout << "Enter the cards in the build you want to capture"
-        << std::endl;
+    GetStream() << "Enter the cards in the build you want to capture"
+        << '\n';
   }
 
   static inline void DisplayRoundStartMessage() {
-    std::cout << "*** ROUND STARTED ***" << std::endl;
+    GetStream() << "*** ROUND STARTED ***" << '\n';
   }
 
   static inline void DisplayFileMessage() {
-    std::cout << "Enter the name of a file" << std::endl;
+    GetStream() << "Enter the name of a file" << '\n';
   }
 
   static inline void DisplayInvalidFileMessage() {
-    std::cout << "*** File doesn't exist, exiting program ***" << std::endl;
+    GetStream() << "*** File doesn't exist, exiting program ***" << '\n';
   }
 
   static inline void DisplayCannotBuildMessage() {
-    std::cout << "*** Can't make that build ***" << std::endl;
+    GetStream() << "*** Can't make that build ***" << '\n';
   }
 
   static inline void DisplayAutomaticCaptureBuildMessage() {
-    std::cout <<
+    GetStream() <<
         "*** Automatically captured all of your builds matching played card ***"
-        << std::endl;
+        << '\n';
   }
 
   static inline void DisplayDeck(const std::shared_ptr<Deck>& deck) {
-    std::cout << deck->ToString() << std::endl;
+    if (IsMuted()) {
+      return;
+    }
+
+    GetStream() << deck->ToString() << '\n';
   }
 
-  static inline void DisplayAiTrailOption(const std::shared_ptr<Card>& card) {
-    std::cout << "The best move is to trail " << card->ToString() << std::endl;
+  static inline void DisplayAiTrailOption(const Card& card) {
+    if (IsMuted()) {
+      return;
+    }
+
+    GetStream() << "The best move is to trail " << card.ToString() << '\n';
+  }
+
+  static inline void DisplayAiSearchOption(const Move& move) {
+    if (IsMuted()) {
+      return;
+    }
+
+    GetStream() << "The searched move is: " << move.ToString() << '\n';
   }
 
   static void DisplayInvalidHelp() {
-    std::cout << "*** Only human can ask for help ***" << std::endl;
+    GetStream() << "*** Only human can ask for help ***" << '\n';
   }
 
   static inline void DisplayNumCards(const std::shared_ptr<Player>& player) {
-    std::cout <<
+    if (IsMuted()) {
+      return;
+    }
+
+    GetStream() <<
         "Player " << player->GetNumber() + 1 << " got " <<
-        player->GetPile().size() << " cards" << std::endl;
+        player->GetPile().size() << " cards" << '\n';
   }
 
   static inline void DisplayNumPoints(const std::shared_ptr<Player>& player) {
-    std::cout <<
+    if (IsMuted()) {
+      return;
+    }
+
+    GetStream() <<
         "Player " << player->GetNumber() + 1 << " has " <<
-        player->GetScore() << " points" << std::endl;
+        player->GetScore() << " points" << '\n';
   }
   
  private:
+  static thread_local OutputSink* sink_;
+  static ConsoleOutput console_;
+
   // Private utils
   static void DisplayBuildOwners(const std::shared_ptr<Table>& table);
 };
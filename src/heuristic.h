@@ -0,0 +1,40 @@
+#ifndef _HEURISTIC_H_
+#define _HEURISTIC_H_
+
+#include "card.h"
+
+// How much the greedy AI wants each card. A weights policy is a struct with
+// a constexpr static Weigh(const Card::Info&), and HeuristicTable runs it
+// over the 52 cards at compile time, so the AI looks a card's score up by id
+// whichever policy it plays with.
+
+// Cards by what they are worth at the end of a round: the ten of diamonds,
+// then aces, then spades (which count towards most spades), then the rest
+struct PointWeights {
+  static constexpr unsigned Weigh(const Card::Info& info) {
+    return info.points == 2 ? 4 : info.is_ace ? 3 :
+        info.suit == Card::kSpades ? 2 : 1;
+  }
+};
+
+template <class Weights>
+struct HeuristicTable {
+  uint8_t scores[Card::kNumCards];
+
+  constexpr HeuristicTable() : scores() {
+    for (unsigned id = 0; id < Card::kNumCards; id++) {
+      scores[id] = Weights::Weigh(kCardTable.cards[id]);
+    }
+  }
+
+  inline unsigned GetScore(const Card& card) const {
+    return scores[card.GetId()];
+  }
+};
+
+// The policy the AI plays with. Builds keep a running total under it too.
+using HeuristicWeights = PointWeights;
+
+constexpr HeuristicTable<HeuristicWeights> kHeuristicTable;
+
+#endif
\ No newline at end of file
@@ -1,18 +1,91 @@
 #include <algorithm>
-#include <unordered_set>
 #include "human.h"
+#include "movegenerator.h"
+#include "movelog.h"
+#include "subsetsum.h"
 #include "inputhandler.h"
 #include "sanitizer.h"
 #include "gui.h"
 #include "serializer.h"
 
 /**
- * Description: Executes the move selected by the player.
+ * Description: Executes the move selected by the player. With an input source
+ *     that can suspend, the move may instead stop to wait for more input; it
+ *     is then not made, IsWaitingForInput is set, and the next call resumes
+ *     it.
  * Parameters: const std::shared_ptr<Table>& table: The current table state.
  * Returns: Whether the move is valid or not.
  */
 
 bool Human::MakeMove(std::shared_ptr<Table>& table) {
+  std::shared_ptr<InputSource> previous = InputHandler::GetSource();
+  std::shared_ptr<InputSource> source = (input_ ? input_ : previous);
+  bool moved = false;
+  InputHandler::SetSource(source);
+
+  if (source && source->CanSuspend()) {
+    moved = ResumeTurn(source, table);
+  } else {
+    moved = PlayTurn(table);
+  }
+
+  InputHandler::SetSource(previous);
+
+  return moved;
+}
+
+/**
+ * Description: Plays the turn on a copy of the hand and the table, so a turn
+ *     whose input runs out part way changes nothing. It is played again from
+ *     its first line once more input has come, and only a finished turn is
+ *     made on the real table, through ApplyMove. Lines read before the turn,
+ *     such as the menu choice, are committed first so they are not read
+ *     again.
+ * Parameters: const std::shared_ptr<InputSource>& source: The source the
+ *     prompts read from.
+ * const std::shared_ptr<Table>& table: The current table state.
+ * Returns: Whether the move was made.
+ */
+
+bool Human::ResumeTurn(const std::shared_ptr<InputSource>& source,
+    std::shared_ptr<Table>& table) {
+  source->Commit();
+  Human scratch;
+  scratch.SetNumber(number_);
+  scratch.SetHand(hand_);
+  scratch.SetPile(pile_);
+  std::shared_ptr<Table> scratch_table = table->Clone();
+  MoveLog::Before before;
+  MoveLog::SaveBefore(scratch, *scratch_table, before);
+
+  bool moved = scratch.PlayTurn(scratch_table);
+  is_waiting_ = InputHandler::IsSuspended();
+
+  if (is_waiting_) {
+    source->Rewind();
+    return false;
+  }
+
+  source->Commit();
+
+  if (!moved) {
+    return false;
+  }
+
+  MoveJournal journal;
+  ApplyMove(MoveLog::GetPlayedMove(before, scratch, *scratch_table), table,
+      journal);
+
+  return true;
+}
+
+/**
+ * Description: Prompts for a move and makes it.
+ * Parameters: const std::shared_ptr<Table>& table: The current table state.
+ * Returns: Whether the move is valid or not.
+ */
+
+bool Human::PlayTurn(std::shared_ptr<Table>& table) {
   std::string card = InputHandler::GetCardInput();
   unsigned card_index = 0;
 
@@ -24,9 +97,8 @@ bool Human::MakeMove(std::shared_ptr<Table>& table) {
   auto card_in_hand = hand_[card_index];
   unsigned action = InputHandler::GetActionInput();
 
-  if (((table->ValueMatchesBuild(card_in_hand->GetValue(), number_)) ||
-      (table->ValueMatchesLooseCard(card_in_hand->GetValue()))) &&
-      (action != kCapture)) {
+  if (MoveGenerator::MustCapture(card_in_hand, number_, table) &&
+      action != kCapture) {
     GUI::DisplayMustCaptureMessage();
     return false;
   }
@@ -57,8 +129,14 @@ bool Human::MakeMove(std::shared_ptr<Table>& table) {
  */
 
 bool Human::CardInHand(const std::string& card, unsigned& card_index) const {
+  Card chosen(card);
+
+  if (!Bitboard::Contains(hand_mask_, chosen)) {
+    return false;
+  }
+
   for (unsigned i = 0; i < hand_.size(); i++) {
-    if (card == hand_[i]->ToString()) {
+    if (chosen == hand_[i]) {
       card_index = i;
       return true;
     }
@@ -68,14 +146,24 @@ bool Human::CardInHand(const std::string& card, unsigned& card_index) const {
 }
 
 /**
- * Description: Trails for the human.
+ * Description: Trails for the human, if the move generator lists the trail.
+ *     A player who owns a build may only trail when they have no other move.
  * Parameters: const unsigned& card_index: The index of the played card.
  * std::shared_ptr<Table>& table: The current table state.
  * Returns: Whether or not the trail was successful.
  */
 
 bool Human::Trail(const unsigned& card_index, std::shared_ptr<Table>& table) {
-  if (table->PlayerOwnsAnyBuilds(number_)) {
+  const MoveList& moves =
+      MoveGenerator::GenerateOnThread(hand_, number_, table);
+  unsigned i = 0;
+
+  while (i < moves.GetSize() && (moves[i].type != Move::kTrail ||
+      moves[i].card_index != card_index)) {
+    i++;
+  }
+
+  if (i == moves.GetSize()) {
     GUI::DisplayOwnsBuildMessage();
     return false;
   }
@@ -94,10 +182,10 @@ bool Human::Trail(const unsigned& card_index, std::shared_ptr<Table>& table) {
 
 bool Human::MakeBuild(
     const unsigned& card_index, std::shared_ptr<Table>& table) {
-  std::vector<std::shared_ptr<Card>> cards;
+  std::vector<Card> cards;
   std::vector<unsigned> card_indices;
   cards.push_back(hand_[card_index]);
-  unsigned build_sum = hand_[card_index]->GetValue();
+  unsigned build_sum = hand_[card_index].GetValue();
   std::vector<std::string> build_cards = InputHandler::GetBuildCardsInput();
 
   if (build_cards.empty()) {
@@ -112,7 +200,7 @@ bool Human::MakeBuild(
 
   for (unsigned i = 0; i < card_indices.size(); i++) {
     auto card = table->GetLooseCard(card_indices[i]);
-    build_sum += card->GetValue();
+    build_sum += card.GetValue();
     cards.push_back(card);
   }
 
@@ -121,7 +209,8 @@ bool Human::MakeBuild(
     return false;
   }
 
-  MakeBuildAction(card_index, cards, card_indices, build_sum, table);
+  MakeBuildAction(card_index, cards, SubsetSum::FromIndices(card_indices),
+      build_sum, table);
 
   return true;
 }
@@ -170,7 +259,7 @@ bool Human::IncreaseBuild(
 
   auto card_in_hand = hand_[card_index];
   auto build = table->GetCurrentBuilds()[build_index];
-  unsigned build_sum = card_in_hand->GetValue() + build->GetBuildSum();
+  unsigned build_sum = card_in_hand.GetValue() + build->GetBuildSum();
 
   if (build->IsMultipleBuild()) {
     GUI::DisplayCannotIncreaseMultiBuildMessage();
@@ -182,7 +271,6 @@ bool Human::IncreaseBuild(
     return false;
   }
 
-  std::cout << build_sum << std::endl;
   if (!HasCardWithBuildSum(card_index, build_sum)) {
     GUI::DisplayCannotBuildMessage();
     return false;
@@ -207,10 +295,10 @@ bool Human::AddToBuild(
     return false;
   }
 
-  std::vector<std::shared_ptr<Card>> cards;
+  std::vector<Card> cards;
   auto card_in_hand = hand_[card_index];
   cards.push_back(card_in_hand);
-  unsigned build_sum = card_in_hand->GetValue();
+  unsigned build_sum = card_in_hand.GetValue();
   std::vector<unsigned> card_indices;
   std::vector<std::string> build_cards_input = InputHandler::GetBuildCardsInput();
 
@@ -223,7 +311,7 @@ bool Human::AddToBuild(
 
   for (unsigned i = 0; i < card_indices.size(); i++) {
     auto card = table->GetLooseCard(card_indices[i]);
-    build_sum += card->GetValue();
+    build_sum += card.GetValue();
     cards.push_back(card);
   }
 
@@ -246,7 +334,8 @@ bool Human::AddToBuild(
     return false;
   }
 
-  AddToBuildAction(card_index, build, cards, card_indices, table);
+  AddToBuildAction(card_index, build, cards,
+      SubsetSum::FromIndices(card_indices), table);
 
   return true;
 }
@@ -262,7 +351,7 @@ bool Human::Capture(
     const unsigned& card_index, std::shared_ptr<Table>& table) {
   bool captured_something = false;
   auto card_in_hand = hand_[card_index];
-  bool played_is_ace = (card_in_hand->IsAce());
+  bool played_is_ace = (card_in_hand.IsAce());
 
   if (!played_is_ace) {
     if (CaptureAllCardsWithSameValue(card_index, table)) {
@@ -291,6 +380,10 @@ bool Human::Capture(
 
     unsigned capture_choice = InputHandler::GetCaptureInput();
 
+    if (InputHandler::IsSuspended()) {
+      return false;
+    }
+
     if (captured_something && capture_choice == kEndTurn) {
       break;
     }
@@ -322,7 +415,7 @@ bool Human::Capture(
     }
   }
 
-  pile_.push_back(card_in_hand);
+  AddToPile(card_in_hand);
   RemoveFromHand(card_index);
   table->SetLastCapturedIndex(number_);
 
@@ -350,22 +443,21 @@ bool Human::CaptureSet(
   unsigned capture_sum = 0;
 
   for (unsigned i = 0; i < card_indices.size(); i++) {
-    capture_sum += table->GetLooseCard(card_indices[i])->GetValue();
+    capture_sum += table->GetLooseCard(card_indices[i]).GetValue();
   }
 
   bool capture_ace_set = false;
 
-  if (capture_sum == Card::kAceTwo && card_in_hand->IsAce()) {
+  if (capture_sum == Card::kAceTwo && card_in_hand.IsAce()) {
     capture_ace_set = true;
   }
 
-  if (!capture_ace_set && capture_sum != card_in_hand->GetValue()) {
-    std::cout << capture_sum << std::endl;
+  if (!capture_ace_set && capture_sum != card_in_hand.GetValue()) {
     GUI::DisplayUnequalCaptureSumMessage();
     return false;
   }
 
-  CaptureSetAction(card_indices, table);
+  CaptureSetAction(SubsetSum::FromIndices(card_indices), table);
 
   return true;
 }
@@ -397,11 +489,11 @@ bool Human::CaptureBuild(
 
   bool capture_ace_build = false;
 
-  if (build->GetBuildSum() == Card::kAceTwo && card_in_hand->IsAce()) {
+  if (build->GetBuildSum() == Card::kAceTwo && card_in_hand.IsAce()) {
     capture_ace_build = true;
   }
 
-  if (!capture_ace_build && build->GetBuildSum() != card_in_hand->GetValue()) {
+  if (!capture_ace_build && build->GetBuildSum() != card_in_hand.GetValue()) {
     GUI::DisplayUnequalBuildSumMessage();
     return false;
   }
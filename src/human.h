@@ -9,11 +9,21 @@
 #define _HUMAN_H_
 
 #include "player.h"
+#include "inputsource.h"
 
 class Human : public Player {
  public:
   // Constructors
-  using Player::Player;
+  Human() : is_waiting_(false) {}
+
+  // Accessors
+  inline bool IsWaitingForInput() const { return is_waiting_; }
+
+  // Mutators
+  // Where the answers to the prompts come from; null for the round's
+  inline void SetInputSource(const std::shared_ptr<InputSource>& input) {
+    input_ = input;
+  }
 
   // Public utils
   bool MakeMove(std::shared_ptr<Table>& table);
@@ -38,7 +48,13 @@ class Human : public Player {
     kEndTurn
   };
 
+  std::shared_ptr<InputSource> input_;
+  bool is_waiting_;
+
   // Private utils
+  bool PlayTurn(std::shared_ptr<Table>& table);
+  bool ResumeTurn(const std::shared_ptr<InputSource>& source,
+      std::shared_ptr<Table>& table);
   bool CardInHand(const std::string& card, unsigned& card_index) const;
   bool Trail(const unsigned& card_index, std::shared_ptr<Table>& table);
   bool MakeBuild(const unsigned& card_index, std::shared_ptr<Table>& table);
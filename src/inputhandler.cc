@@ -5,23 +5,54 @@
  * Due Date: 10/2/18           *
  *******************************/
 
-#include <iostream>
 #include "gui.h"
 #include "sanitizer.h"
 #include "inputhandler.h"
 #include "serializer.h"
 
+thread_local std::shared_ptr<InputSource> InputHandler::source_;
+thread_local bool InputHandler::is_suspended_ = false;
+
 /**
- * Description: Gets a string from stdin.
+ * Description: Sets where this thread's prompts read from and clears any
+ *     suspension.
+ * Parameters: const std::shared_ptr<InputSource>& source: The source, or null
+ *     for stdin.
+ * Returns: Nothing.
+ */
+
+void InputHandler::SetSource(const std::shared_ptr<InputSource>& source) {
+  source_ = source;
+  is_suspended_ = false;
+}
+
+/**
+ * Description: Gets a string from the input source. Once the source has run
+ *     out, every prompt returns empty until the source is set again.
  * Parameters: None.
  * Returns: The entered string.
  */
 
 std::string InputHandler::GetStringInput() {
+  static thread_local ConsoleInput console;
   std::string choice;
-  getline(std::cin, choice);
 
-  return choice;
+  if (!is_suspended_ &&
+      !(source_ ? source_->ReadLine(choice) : console.ReadLine(choice))) {
+    is_suspended_ = true;
+  }
+
+  return is_suspended_ ? std::string() : choice;
+}
+
+/**
+ * Description: Converts a validated menu choice to its number.
+ * Parameters: const std::string& choice: The choice.
+ * Returns: The number, or 0 if the prompt was suspended.
+ */
+
+unsigned InputHandler::ToChoice(const std::string& choice) {
+  return is_suspended_ ? 0 : Serializer::GetIntFromString(choice);
 }
 
 /**
@@ -37,7 +68,7 @@ std::string InputHandler::GetCardInput() {
     GUI::DisplayCardPlayMessage();
     choice = InputHandler::GetStringInput();
 
-    if (Sanitizer::CardChoiceValid(choice)) {
+    if (is_suspended_ || Sanitizer::CardChoiceValid(choice)) {
       break;
     }
 
@@ -60,14 +91,14 @@ unsigned InputHandler::GetActionInput() {
     GUI::DisplayActionMenu();
     choice = InputHandler::GetStringInput();
 
-    if (Sanitizer::ActionChoiceValid(choice)) {
+    if (is_suspended_ || Sanitizer::ActionChoiceValid(choice)) {
       break;
     }
 
     GUI::DisplayInvalidChoiceMessage();
   }
 
-  return Serializer::GetIntFromString(choice);
+  return ToChoice(choice);
 }
 
 /**
@@ -83,14 +114,14 @@ unsigned InputHandler::GetBuildInput() {
     GUI::DisplayBuildMenu();
     choice = InputHandler::GetStringInput();
 
-    if (Sanitizer::BuildOptionValid(choice)) {
+    if (is_suspended_ || Sanitizer::BuildOptionValid(choice)) {
       break;
     }
 
     GUI::DisplayInvalidChoiceMessage();
   }
 
-  return Serializer::GetIntFromString(choice);
+  return ToChoice(choice);
 }
 
 /**
@@ -106,14 +137,14 @@ unsigned InputHandler::GetCaptureInput() {
     GUI::DisplayCaptureMenu();
     choice = InputHandler::GetStringInput();
 
-    if (Sanitizer::CaptureChoiceValid(choice)) {
+    if (is_suspended_ || Sanitizer::CaptureChoiceValid(choice)) {
       break;
     }
 
     GUI::DisplayInvalidChoiceMessage();
   }
 
-  return Serializer::GetIntFromString(choice);
+  return ToChoice(choice);
 }
 
 /**
@@ -130,7 +161,7 @@ std::vector<std::string> InputHandler::GetBuildCardsInput() {
     GUI::DisplayBuildCardsMessage();
     choice = InputHandler::GetStringInput();
 
-    if (Sanitizer::CardsValid(choice, str_cards)) {
+    if (is_suspended_ || Sanitizer::CardsValid(choice, str_cards)) {
       break;
     }
 
@@ -154,10 +185,9 @@ std::vector<std::string> InputHandler::GetBuildAddOnInput() {
     GUI::DisplayBuildAddOnMessage();
     choice = InputHandler::GetStringInput();
 
-    if (Sanitizer::CardsValid(choice, str_cards)) {
-      if (!str_cards.empty()) {
-        break;
-      }
+    if (is_suspended_ ||
+        (Sanitizer::CardsValid(choice, str_cards) && !str_cards.empty())) {
+      break;
     }
 
     GUI::DisplayInvalidChoiceMessage();
@@ -180,10 +210,9 @@ std::vector<std::string> InputHandler::GetCaptureSetInput() {
     GUI::DisplayCaptureSetMessage();
     choice = InputHandler::GetStringInput();
 
-    if (Sanitizer::CardsValid(choice, str_cards)) {
-      if (!str_cards.empty()) {
-        break;
-      }
+    if (is_suspended_ ||
+        (Sanitizer::CardsValid(choice, str_cards) && !str_cards.empty())) {
+      break;
     }
 
     GUI::DisplayInvalidChoiceMessage();
@@ -206,10 +235,9 @@ std::vector<std::string> InputHandler::GetCaptureBuildInput() {
     GUI::DisplayCaptureBuildMessage();
     choice = InputHandler::GetStringInput();
 
-    if (Sanitizer::CardsValid(choice, str_cards)) {
-      if (!str_cards.empty()) {
-        break;
-      }
+    if (is_suspended_ ||
+        (Sanitizer::CardsValid(choice, str_cards) && !str_cards.empty())) {
+      break;
     }
 
     GUI::DisplayInvalidChoiceMessage();
@@ -243,14 +271,14 @@ unsigned InputHandler::GetMenuInput() {
     GUI::DisplayMenu();
     choice = InputHandler::GetStringInput();
 
-    if (Sanitizer::MenuChoiceValid(choice)) {
+    if (is_suspended_ || Sanitizer::MenuChoiceValid(choice)) {
       break;
     }
 
     GUI::DisplayInvalidChoiceMessage();
   }
 
-  return Serializer::GetIntFromString(choice);
+  return ToChoice(choice);
 }
 
 /**
@@ -266,7 +294,7 @@ std::string InputHandler::GetFileInput() {
     GUI::DisplayFileMessage();
     file_name = InputHandler::GetStringInput();
 
-    if (Sanitizer::FileValid(file_name)) {
+    if (is_suspended_ || Sanitizer::FileValid(file_name)) {
       break;
     }
 
@@ -289,14 +317,14 @@ unsigned InputHandler::GetDeckInput() {
     GUI::DisplayDeckMenu();
     choice = InputHandler::GetStringInput();
 
-    if (Sanitizer::DeckChoiceValid(choice)) {
+    if (is_suspended_ || Sanitizer::DeckChoiceValid(choice)) {
       break;
     }
 
     GUI::DisplayInvalidChoiceMessage();
   }
 
-  return Serializer::GetIntFromString(choice);
+  return ToChoice(choice);
 }
 
 /**
@@ -312,14 +340,14 @@ unsigned InputHandler::GetCoinInput() {
     GUI::DisplayCoinMessage();
     choice = InputHandler::GetStringInput();
 
-    if (Sanitizer::CoinChoiceValid(choice)) {
+    if (is_suspended_ || Sanitizer::CoinChoiceValid(choice)) {
       break;
     }
 
     GUI::DisplayInvalidChoiceMessage();
   }
 
-  return Serializer::GetIntFromString(choice);
+  return ToChoice(choice);
 }
 
 /**
@@ -335,12 +363,12 @@ unsigned InputHandler::GetLoadChoiceInput() {
     GUI::DisplayLoadMenu();
     choice = InputHandler::GetStringInput();
 
-    if (Sanitizer::LoadChoiceValid(choice)) {
+    if (is_suspended_ || Sanitizer::LoadChoiceValid(choice)) {
       break;
     }
 
     GUI::DisplayInvalidChoiceMessage();
   }
 
-  return Serializer::GetIntFromString(choice);
+  return ToChoice(choice);
 }
\ No newline at end of file
@@ -8,10 +8,25 @@
 #ifndef _INPUT_HANDLER_H_
 #define _INPUT_HANDLER_H_
 
+#include <memory>
 #include <string>
+#include <vector>
+#include "inputsource.h"
 
+// Prompts for and validates input. Each thread reads from stdin unless given
+// another source; a source that runs out suspends the prompts instead of
+// blocking, and they all return empty answers until the source is set again.
 class InputHandler {
  public:
+  // Accessors
+  static inline bool IsSuspended() { return is_suspended_; }
+  static inline const std::shared_ptr<InputSource>& GetSource() {
+    return source_;
+  }
+
+  // Mutators
+  static void SetSource(const std::shared_ptr<InputSource>& source);
+
   // Public utils
   static std::string GetCardInput();
   static unsigned GetActionInput();
@@ -30,8 +45,12 @@ class InputHandler {
   static unsigned GetLoadChoiceInput();
 
  private:
+  static thread_local std::shared_ptr<InputSource> source_;
+  static thread_local bool is_suspended_;
+
   // Private utils
   static std::string GetStringInput();
+  static unsigned ToChoice(const std::string& choice);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,108 @@
+#include <iostream>
+#include "inputsource.h"
+
+/**
+ * Description: Reads a line from stdin.
+ * Parameters: std::string& line: An input parameter set to the line.
+ * Returns: Always true; it waits for the line.
+ */
+
+bool ConsoleInput::ReadLine(std::string& line) {
+  getline(std::cin, line);
+
+  return true;
+}
+
+/**
+ * Description: Checks for lines that have not been read yet.
+ * Parameters: None.
+ * Returns: Whether there are any.
+ */
+
+bool InputQueue::HasUnread() {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  return num_read_ < lines_.size();
+}
+
+/**
+ * Description: Counts the lines that have not been read yet.
+ * Parameters: None.
+ * Returns: The count.
+ */
+
+unsigned InputQueue::GetNumUnread() {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  return lines_.size() - num_read_;
+}
+
+/**
+ * Description: Adds a line. Safe to call from any thread.
+ * Parameters: const std::string& line: The line.
+ * Returns: Nothing.
+ */
+
+void InputQueue::Push(const std::string& line) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    lines_.push_back(line);
+  }
+
+  if (on_input_) {
+    on_input_();
+  }
+}
+
+/**
+ * Description: Reads the next unread line.
+ * Parameters: std::string& line: An input parameter set to the line.
+ * Returns: Whether there was one.
+ */
+
+bool InputQueue::ReadLine(std::string& line) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (num_read_ == lines_.size()) {
+    return false;
+  }
+
+  line = lines_[num_read_++];
+
+  return true;
+}
+
+/**
+ * Description: Marks every line since the last commit unread again.
+ * Parameters: None.
+ * Returns: Nothing.
+ */
+
+void InputQueue::Rewind() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  num_read_ = 0;
+}
+
+/**
+ * Description: Drops the lines read so far.
+ * Parameters: None.
+ * Returns: Nothing.
+ */
+
+void InputQueue::Commit() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  lines_.erase(lines_.begin(), lines_.begin() + num_read_);
+  num_read_ = 0;
+}
+
+/**
+ * Description: Drops every line, read or not.
+ * Parameters: None.
+ * Returns: Nothing.
+ */
+
+void InputQueue::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  lines_.clear();
+  num_read_ = 0;
+}
\ No newline at end of file
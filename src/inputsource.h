@@ -0,0 +1,77 @@
+#ifndef _INPUT_SOURCE_H_
+#define _INPUT_SOURCE_H_
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+
+// Where the answers to a human's prompts come from. A source that can suspend
+// may have no line ready yet, in which case the prompt gives up instead of
+// blocking and the turn is tried again once more lines have come.
+class InputSource {
+ public:
+  virtual ~InputSource() = default;
+
+  // Accessors
+  virtual bool CanSuspend() const = 0;
+
+  // Public utils
+  // Gets the next line, or returns false if there is none yet
+  virtual bool ReadLine(std::string& line) = 0;
+
+  // Goes back to the first line read since the last commit, so a suspended
+  // turn can be played again from its start
+  virtual void Rewind() {}
+
+  // Drops every line read so far
+  virtual void Commit() {}
+};
+
+// Reads from stdin, blocking until a line is entered.
+class ConsoleInput : public InputSource {
+ public:
+  // Accessors
+  inline bool CanSuspend() const { return false; }
+
+  // Public utils
+  bool ReadLine(std::string& line);
+};
+
+// Lines handed over by another thread, e.g. from a remote player. Reading
+// never blocks, so a table waiting on the player does not hold a thread.
+class InputQueue : public InputSource {
+ public:
+  using Callback = std::function<void()>;
+
+  // Delete copy constructor and assignment operator
+  InputQueue(const InputQueue& input_queue) = delete;
+  InputQueue& operator=(const InputQueue& input_queue) = delete;
+
+  // Constructors
+  InputQueue() : num_read_(0) {}
+
+  // Accessors
+  inline bool CanSuspend() const { return true; }
+  bool HasUnread();
+  unsigned GetNumUnread();
+
+  // Mutators
+  // Called after every push, e.g. to step the waiting round again
+  inline void SetOnInput(const Callback& on_input) { on_input_ = on_input; }
+
+  // Public utils
+  void Push(const std::string& line);
+  bool ReadLine(std::string& line);
+  void Rewind();
+  void Commit();
+  void Clear();
+
+ private:
+  std::mutex mutex_;
+  std::deque<std::string> lines_;
+  size_t num_read_;
+  Callback on_input_;
+};
+
+#endif
\ No newline at end of file
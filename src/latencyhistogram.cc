@@ -0,0 +1,136 @@
+#include <sstream>
+#include "latencyhistogram.h"
+
+/**
+ * Description: Records a single latency sample.
+ * Parameters: const uint64_t& nanos: The latency in nanoseconds.
+ * Returns: Nothing.
+ */
+
+void LatencyHistogram::Record(const uint64_t& nanos) {
+  buckets_[GetBucketIndex(nanos)]++;
+  count_++;
+  total_ += nanos;
+
+  if (nanos > max_) {
+    max_ = nanos;
+  }
+}
+
+/**
+ * Description: Adds the samples of another histogram to this one.
+ * Parameters: const LatencyHistogram& other: The histogram to merge in.
+ * Returns: Nothing.
+ */
+
+void LatencyHistogram::Merge(const LatencyHistogram& other) {
+  for (unsigned i = 0; i < kNumBuckets; i++) {
+    buckets_[i] += other.buckets_[i];
+  }
+
+  count_ += other.count_;
+  total_ += other.total_;
+
+  if (other.max_ > max_) {
+    max_ = other.max_;
+  }
+}
+
+/**
+ * Description: Removes all recorded samples.
+ * Parameters: None.
+ * Returns: Nothing.
+ */
+
+void LatencyHistogram::Clear() {
+  for (unsigned i = 0; i < kNumBuckets; i++) {
+    buckets_[i] = 0;
+  }
+
+  count_ = 0;
+  total_ = 0;
+  max_ = 0;
+}
+
+/**
+ * Description: Gets an upper bound on the given percentile of the samples.
+ * Parameters: const double& percentile: The percentile, between 0 and 100.
+ * Returns: The latency in nanoseconds (accurate to one eighth of an octave).
+ */
+
+uint64_t LatencyHistogram::GetPercentile(const double& percentile) const {
+  if (!count_) {
+    return 0;
+  }
+
+  uint64_t rank = (uint64_t) (percentile / 100.0 * count_);
+  uint64_t seen = 0;
+
+  if (rank >= count_) {
+    rank = count_ - 1;
+  }
+
+  for (unsigned i = 0; i < kNumBuckets; i++) {
+    seen += buckets_[i];
+
+    if (seen > rank) {
+      uint64_t upper_bound = GetBucketUpperBound(i);
+      return upper_bound < max_ ? upper_bound : max_;
+    }
+  }
+
+  return max_;
+}
+
+/**
+ * Description: Summarizes the histogram as a string.
+ * Parameters: None.
+ * Returns: The summary string.
+ */
+
+std::string LatencyHistogram::ToString() const {
+  std::ostringstream summary;
+  summary << "n=" << count_ << " mean=" << (uint64_t) GetMean() << "ns"
+          << " p50=" << GetPercentile(50) << "ns"
+          << " p99=" << GetPercentile(99) << "ns"
+          << " max=" << max_ << "ns";
+
+  return summary.str();
+}
+
+/**
+ * Description: Maps a latency to its bucket. Every power of two is split into
+ *     kSubBuckets linear buckets.
+ * Parameters: const uint64_t& nanos: The latency in nanoseconds.
+ * Returns: The bucket index.
+ */
+
+unsigned LatencyHistogram::GetBucketIndex(const uint64_t& nanos) {
+  if (nanos < kSubBuckets) {
+    return nanos;
+  }
+
+  unsigned msb = 63 - __builtin_clzll(nanos);
+  unsigned shift = msb - kSubBucketBits;
+  unsigned mantissa = (nanos >> shift) & (kSubBuckets - 1);
+
+  return (shift + 1) * kSubBuckets + mantissa;
+}
+
+/**
+ * Description: Gets the largest latency that falls into a bucket.
+ * Parameters: const unsigned& index: The bucket index.
+ * Returns: The latency in nanoseconds.
+ */
+
+uint64_t LatencyHistogram::GetBucketUpperBound(const unsigned& index) {
+  if (index < kSubBuckets) {
+    return index;
+  }
+
+  unsigned shift = index / kSubBuckets - 1;
+  uint64_t mantissa = index % kSubBuckets;
+  uint64_t lower_bound = (kSubBuckets + mantissa) << shift;
+
+  return lower_bound + ((uint64_t) 1 << shift) - 1;
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#ifndef _LATENCY_HISTOGRAM_H_
+#define _LATENCY_HISTOGRAM_H_
+
+#include <cstdint>
+#include <string>
+
+class LatencyHistogram {
+ public:
+  // Constructors
+  LatencyHistogram() { Clear(); }
+
+  // Accessors
+  inline uint64_t GetCount() const { return count_; }
+  inline uint64_t GetTotal() const { return total_; }
+  inline uint64_t GetMax() const { return max_; }
+  inline double GetMean() const {
+    return count_ ? (double) total_ / count_ : 0.0;
+  }
+
+  // Public utils
+  void Record(const uint64_t& nanos);
+  void Merge(const LatencyHistogram& other);
+  void Clear();
+  uint64_t GetPercentile(const double& percentile) const;
+  std::string ToString() const;
+
+ private:
+  // Private constants
+  static const unsigned kSubBucketBits = 3;
+  static const unsigned kSubBuckets = 1 << kSubBucketBits;
+  static const unsigned kNumBuckets = 64 * kSubBuckets;
+
+  uint64_t buckets_[kNumBuckets];
+  uint64_t count_;
+  uint64_t total_;
+  uint64_t max_;
+
+  // Private utils
+  static unsigned GetBucketIndex(const uint64_t& nanos);
+  static uint64_t GetBucketUpperBound(const unsigned& index);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,573 @@
+#include <cmath>
+#include <thread>
+#include "montecarlosearch.h"
+#include "computer.h"
+#include "round.h"
+
+const unsigned MonteCarloSearch::kDealStep;
+const int MonteCarloSearch::kInfinity;
+const unsigned MonteCarloSearch::kSolverTableBits;
+
+// 50 ms on one thread with no iteration cap
+const MonteCarloSearch::Config MonteCarloSearch::kDefaultConfig =
+    {50, 0, 1, 0.7, nullptr};
+
+/**
+ * Description: Sets up one thread's tree and its private copy of the game.
+ * Parameters: const Root& root: The position to search from.
+ * const Config& config: The search settings.
+ * const uint64_t& seed: The seed of this tree's random stream.
+ * Returns: Nothing.
+ */
+
+MonteCarloSearch::Tree::Tree(
+    const Root& root, const Config& config, const uint64_t& seed) :
+    root(root), config(config), rng(seed), table(new Table),
+    deck_index(0), num_iterations(0) {
+  for (unsigned i = 0; i < 2; i++) {
+    std::vector<Card> pile;
+
+    for (unsigned id = 0; id < Card::kNumCards; id++) {
+      if (root.piles[i] & (1ULL << id)) {
+        pile.push_back(Card::FromId(id));
+      }
+    }
+
+    players[i] = std::shared_ptr<Player>(new Computer);
+    players[i]->SetNumber(i);
+    players[i]->SetIsVerbose(false);
+    players[i]->SetPile(pile);
+  }
+
+  players[root.self_number]->SetHand(root.hand);
+  table->SetLooseCards(root.loose_cards);
+  table->SetLastCapturedIndex(root.last_captured_index);
+
+  for (unsigned i = 0; i < root.builds.size(); i++) {
+    table->AddBuild(root.builds[i]->Clone());
+  }
+
+  Node node = {Move(), root.self_number ^ 1, kNoNode, kNoNode, kNoNode,
+      0, 0, 0.0};
+  nodes.push_back(node);
+}
+
+/**
+ * Description: Finds the move to play. The opponent's hand and the deck are
+ *     only used for their sizes; their cards are guessed from the unseen ones.
+ * Parameters: const Player& self: The player to move.
+ * const Player& opponent: The other player.
+ * const std::shared_ptr<Table>& table: The current table state.
+ * const unsigned& deck_size: The number of cards left in the deck.
+ * const uint64_t& seed: The seed of the search. With an iteration budget and
+ *     one thread, the same seed always picks the same move.
+ * Returns: The move with the most visits.
+ */
+
+Move MonteCarloSearch::Search(
+    const Player& self, const Player& opponent,
+    const std::shared_ptr<Table>& table, const unsigned& deck_size,
+    const uint64_t& seed) {
+  Root root;
+  root.self_number = self.GetNumber();
+  root.hand = self.GetHand();
+  root.piles[root.self_number] = self.GetPileMask();
+  root.piles[root.self_number ^ 1] = opponent.GetPileMask();
+  root.loose_cards = table->GetLooseCards();
+  root.builds = table->GetCurrentBuilds();
+  root.last_captured_index = table->GetLastCapturedIndex();
+  root.opponent_hand_size = opponent.GetHand().size();
+  root.deck_size = deck_size;
+  uint64_t seen = self.GetHandMask() | root.piles[0] | root.piles[1] |
+      table->GetLooseMask();
+
+  for (unsigned i = 0; i < root.builds.size(); i++) {
+    seen |= root.builds[i]->GetCardMask();
+  }
+
+  for (unsigned id = 0; id < Card::kNumCards; id++) {
+    if (!(seen & (1ULL << id))) {
+      root.unseen.push_back(Card::FromId(id));
+    }
+  }
+
+  // The unseen cards are split between the opponent and the deck
+  if (root.unseen.size() < root.opponent_hand_size) {
+    root.opponent_hand_size = root.unseen.size();
+  }
+
+  if (root.unseen.size() - root.opponent_hand_size < deck_size) {
+    root.deck_size = root.unseen.size() - root.opponent_hand_size;
+  }
+
+  num_iterations_ = 0;
+
+  // Without a deck the opponent holds exactly the unseen cards
+  if (!root.deck_size && root.unseen.size() == root.opponent_hand_size) {
+    std::shared_ptr<TranspositionTable> transpositions =
+        config_.transpositions;
+
+    if (!transpositions) {
+      transpositions = std::shared_ptr<TranspositionTable>(
+          new TranspositionTable(kSolverTableBits));
+    }
+
+    Tree tree(root, config_, seed);
+    Determinize(tree);
+    Move move;
+
+    if (SolveEndgame(tree, *transpositions, move)) {
+      return move;
+    }
+  }
+
+  unsigned num_threads = config_.num_threads ? config_.num_threads : 1;
+  unsigned long max_iterations = config_.iterations ?
+      (config_.iterations + num_threads - 1) / num_threads : 0;
+  Clock::time_point deadline =
+      Clock::now() + std::chrono::milliseconds(config_.millis);
+  std::vector<std::shared_ptr<Tree>> trees;
+
+  for (unsigned i = 0; i < num_threads; i++) {
+    trees.push_back(std::shared_ptr<Tree>(
+        new Tree(root, config_, Random::GetGameSeed(seed, i))));
+  }
+
+  std::vector<std::thread> threads;
+
+  for (unsigned i = 1; i < num_threads; i++) {
+    threads.push_back(std::thread(
+        Grow, std::ref(*trees[i]), deadline, max_iterations));
+  }
+
+  Grow(*trees[0], deadline, max_iterations);
+
+  for (unsigned i = 0; i < threads.size(); i++) {
+    threads[i].join();
+  }
+
+  // Sum the root children of every tree and take the most visited
+  std::vector<Node> totals;
+
+  for (unsigned i = 0; i < trees.size(); i++) {
+    const std::vector<Node>& nodes = trees[i]->nodes;
+    num_iterations_ += trees[i]->num_iterations;
+
+    for (unsigned j = nodes[0].first_child; j != kNoNode;
+        j = nodes[j].next_sibling) {
+      unsigned k = 0;
+
+      while (k < totals.size() && !IsSameMove(totals[k].move, nodes[j].move)) {
+        k++;
+      }
+
+      if (k == totals.size()) {
+        totals.push_back(nodes[j]);
+      } else {
+        totals[k].visits += nodes[j].visits;
+        totals[k].reward += nodes[j].reward;
+      }
+    }
+  }
+
+  unsigned best = 0;
+
+  for (unsigned i = 1; i < totals.size(); i++) {
+    if (totals[i].visits > totals[best].visits) {
+      best = i;
+    }
+  }
+
+  return totals[best].move;
+}
+
+/**
+ * Description: Runs iterations on one tree until the deadline passes or the
+ *     iteration budget is spent, whichever comes first.
+ * Parameters: Tree& tree: The tree to grow.
+ * const Clock::time_point& deadline: When to stop, if there is a time budget.
+ * const unsigned long& max_iterations: When to stop, if nonzero.
+ * Returns: Nothing.
+ */
+
+void MonteCarloSearch::Grow(
+    Tree& tree, const Clock::time_point& deadline,
+    const unsigned long& max_iterations) {
+  bool has_deadline = tree.config.millis || !max_iterations;
+
+  while (!max_iterations || tree.num_iterations < max_iterations) {
+    if (has_deadline && tree.num_iterations % kIterationsPerClockCheck == 0 &&
+        Clock::now() >= deadline && tree.num_iterations) {
+      break;
+    }
+
+    Iterate(tree);
+    tree.num_iterations++;
+  }
+}
+
+/**
+ * Description: Runs one iteration: deal a guess of the hidden cards, walk down
+ *     the tree, add one node, play the round out and back up the score. The
+ *     game is then taken back to the root through the move journal.
+ * Parameters: Tree& tree: The tree to grow.
+ * Returns: Nothing.
+ */
+
+void MonteCarloSearch::Iterate(Tree& tree) {
+  Determinize(tree);
+  unsigned node = 0;
+  unsigned turn = tree.root.self_number;
+  bool in_tree = true;
+  tree.path.clear();
+  tree.steps.clear();
+
+  while (true) {
+    if (tree.players[0]->GetHand().empty() &&
+        tree.players[1]->GetHand().empty()) {
+      if (tree.deck_index == tree.deck.size()) {
+        break;
+      }
+
+      // Deal four cards each, as Deck::DealNext does
+      for (unsigned i = 0; i < 2; i++) {
+        tree.players[i]->SetHand(std::vector<Card>(
+            tree.deck.begin() + tree.deck_index,
+            tree.deck.begin() + tree.deck_index + 4));
+        tree.deck_index += 4;
+      }
+
+      tree.steps.push_back(kDealStep);
+    }
+
+    Player& player = *tree.players[turn];
+    tree.generator.Generate(player.GetHand(), turn, tree.table, tree.moves);
+    Move move;
+
+    if (in_tree) {
+      bool expanded = false;
+      node = SelectOrExpand(tree, node, turn, move, expanded);
+      tree.path.push_back(node);
+      in_tree = !expanded;
+    } else {
+      move = PickRolloutMove(tree);
+    }
+
+    player.ApplyMove(move, tree.table, tree.journal);
+    tree.steps.push_back(turn);
+    turn ^= 1;
+  }
+
+  double reward = Evaluate(tree);
+  tree.nodes[0].visits++;
+
+  for (unsigned i = 0; i < tree.path.size(); i++) {
+    Node& visited = tree.nodes[tree.path[i]];
+    visited.visits++;
+    visited.reward +=
+        (visited.mover == tree.root.self_number ? reward : 1.0 - reward);
+  }
+
+  for (unsigned i = tree.steps.size(); i-- > 0;) {
+    if (tree.steps[i] == kDealStep) {
+      tree.players[0]->ClearHand();
+      tree.players[1]->ClearHand();
+      tree.deck_index -= 8;
+    } else {
+      tree.players[tree.steps[i]]->UndoMove(tree.table, tree.journal);
+    }
+  }
+}
+
+/**
+ * Description: Deals the unseen cards into a random opponent hand and deck.
+ * Parameters: Tree& tree: The tree being grown.
+ * Returns: Nothing.
+ */
+
+void MonteCarloSearch::Determinize(Tree& tree) {
+  std::vector<Card>& unseen = tree.deck;
+  unseen = tree.root.unseen;
+
+  for (unsigned i = unseen.size(); i > 1; i--) {
+    unsigned j = tree.rng.NextBelow(i);
+    Card temp = unseen[i - 1];
+    unseen[i - 1] = unseen[j];
+    unseen[j] = temp;
+  }
+
+  unsigned hand_size = tree.root.opponent_hand_size;
+  tree.players[tree.root.self_number ^ 1]->SetHand(
+      std::vector<Card>(unseen.begin(), unseen.begin() + hand_size));
+  unseen.erase(unseen.begin(), unseen.begin() + hand_size);
+
+  // Only whole deals are played out
+  unseen.resize(tree.root.deck_size - tree.root.deck_size % 8);
+  tree.deck_index = 0;
+}
+
+/**
+ * Description: Picks the move to follow from a tree node. Legal moves that
+ *     have no child yet are tried first; otherwise the child with the best
+ *     upper confidence bound is followed. Which moves are legal depends on
+ *     the guess, so the bound uses how often each child was available.
+ * Parameters: Tree& tree: The tree being grown.
+ * const unsigned& node: The current node.
+ * const unsigned& mover: The number of the player to move.
+ * Move& move: An input parameter set to the move to play.
+ * bool& expanded: An input parameter set when a new node was added.
+ * Returns: The index of the child followed.
+ */
+
+unsigned MonteCarloSearch::SelectOrExpand(
+    Tree& tree, const unsigned& node, const unsigned& mover, Move& move,
+    bool& expanded) {
+  unsigned num_untried = 0;
+  unsigned untried = 0;
+  unsigned best = kNoNode;
+  double best_score = -1.0;
+
+  for (unsigned i = 0; i < tree.moves.GetSize(); i++) {
+    unsigned child = tree.nodes[node].first_child;
+
+    while (child != kNoNode && !IsSameMove(tree.nodes[child].move,
+        tree.moves[i])) {
+      child = tree.nodes[child].next_sibling;
+    }
+
+    if (child == kNoNode) {
+      // Reservoir sampling keeps a uniform choice among the untried moves
+      if (tree.rng.NextBelow(++num_untried) == 0) {
+        untried = i;
+      }
+
+      continue;
+    }
+
+    Node& candidate = tree.nodes[child];
+    candidate.avails++;
+    double score = candidate.reward / candidate.visits +
+        tree.config.exploration *
+        std::sqrt(std::log((double) candidate.avails) / candidate.visits);
+
+    if (score > best_score) {
+      best_score = score;
+      best = child;
+    }
+  }
+
+  if (num_untried) {
+    Node child = {tree.moves[untried], mover, node,
+        kNoNode, tree.nodes[node].first_child, 0, 1, 0.0};
+    tree.nodes.push_back(child);
+    tree.nodes[node].first_child = tree.nodes.size() - 1;
+    move = tree.moves[untried];
+    expanded = true;
+
+    return tree.nodes.size() - 1;
+  }
+
+  // The child's card index may be stale, so play the legal twin
+  for (unsigned i = 0; i < tree.moves.GetSize(); i++) {
+    if (IsSameMove(tree.moves[i], tree.nodes[best].move)) {
+      move = tree.moves[i];
+    }
+  }
+
+  return best;
+}
+
+/**
+ * Description: Picks a move for the playout past the tree. Captures are taken
+ *     whenever there is one, otherwise any move is played at random.
+ * Parameters: Tree& tree: The tree being grown.
+ * Returns: The move.
+ */
+
+const Move& MonteCarloSearch::PickRolloutMove(Tree& tree) {
+  unsigned num_captures = 0;
+  unsigned capture = 0;
+
+  for (unsigned i = 0; i < tree.moves.GetSize(); i++) {
+    if (tree.moves[i].type == Move::kCapture &&
+        tree.rng.NextBelow(++num_captures) == 0) {
+      capture = i;
+    }
+  }
+
+  if (num_captures) {
+    return tree.moves[capture];
+  }
+
+  return tree.moves[tree.rng.NextBelow(tree.moves.GetSize())];
+}
+
+/**
+ * Description: Scores a finished round for the searching player.
+ * Parameters: const Tree& tree: The tree, with its game at the end of a round.
+ * Returns: The reward, from 0 (lost every point) to 1 (won every point).
+ */
+
+double MonteCarloSearch::Evaluate(const Tree& tree) {
+  static const double kMaxPoints = 11.0;
+
+  return 0.5 + GetMargin(tree, tree.root.self_number) / (2 * kMaxPoints);
+}
+
+/**
+ * Description: Checks if two moves are the same play. The card index is left
+ *     out since the same card can sit at different places in guessed hands.
+ * Parameters: const Move& one: The first move.
+ * const Move& two: The second move.
+ * Returns: Whether they are the same play.
+ */
+
+bool MonteCarloSearch::IsSameMove(const Move& one, const Move& two) {
+  return one.type == two.type && one.card == two.card &&
+      one.build_index == two.build_index && one.build_mask == two.build_mask &&
+      one.loose_mask == two.loose_mask;
+}
+
+/**
+ * Description: Solves the rest of the round when every card is known.
+ * Parameters: Tree& tree: A tree whose game holds both real hands.
+ * TranspositionTable& transpositions: The table of solved positions.
+ * Move& move: An input parameter set to the best move.
+ * Returns: Whether the round was solved within the node budget.
+ */
+
+bool MonteCarloSearch::SolveEndgame(
+    Tree& tree, TranspositionTable& transpositions, Move& move) {
+  unsigned long budget = kMaxSolverNodes;
+  Solve(tree, transpositions, tree.root.self_number, -kInfinity, kInfinity,
+      budget, &move);
+
+  return budget;
+}
+
+/**
+ * Description: Finds the best point margin the player to move can force
+ *     (negamax with alpha-beta). The move a position was last solved with is
+ *     tried first, then captures, then the rest.
+ * Parameters: Tree& tree: The tree, with its game at the position to solve.
+ * TranspositionTable& transpositions: The table of solved positions.
+ * const unsigned& turn: The number of the player to move.
+ * int alpha: The margin the player to move is already sure of.
+ * const int& beta: The margin the opponent already holds the player to.
+ * unsigned long& budget: The nodes left to search; zero once it runs out,
+ *     and then the result is meaningless.
+ * Move* best_move: Set to the best move at the root, null below it.
+ * Returns: The margin for the player to move.
+ */
+
+int MonteCarloSearch::Solve(
+    Tree& tree, TranspositionTable& transpositions, const unsigned& turn,
+    int alpha, const int& beta, unsigned long& budget, Move* best_move) {
+  Player& player = *tree.players[turn];
+  unsigned depth = player.GetHand().size() +
+      tree.players[turn ^ 1]->GetHand().size();
+
+  if (!depth) {
+    return GetMargin(tree, turn);
+  }
+
+  if (!budget) {
+    return 0;
+  }
+
+  budget--;
+  uint64_t key = tree.players[0]->GetHash() ^ tree.players[1]->GetHash() ^
+      tree.table->GetHash() ^ kZobristKeys.side[turn];
+  TranspositionTable::Entry entry;
+  unsigned first = MoveList::kMaxMoves;
+
+  if (transpositions.Probe(key, entry)) {
+    first = entry.move_index;
+
+    if (!best_move && (entry.bound == TranspositionTable::kExact ||
+        (entry.bound == TranspositionTable::kLower && entry.value >= beta) ||
+        (entry.bound == TranspositionTable::kUpper && entry.value <= alpha))) {
+      return entry.value;
+    }
+  }
+
+  MoveList moves;
+  tree.generator.Generate(player.GetHand(), turn, tree.table, moves);
+  unsigned order[MoveList::kMaxMoves];
+  unsigned num_ordered = 0;
+
+  if (first < moves.GetSize()) {
+    order[num_ordered++] = first;
+  }
+
+  for (unsigned pass = 0; pass < 2; pass++) {
+    for (unsigned i = 0; i < moves.GetSize(); i++) {
+      if (i != first && (moves[i].type == Move::kCapture) == !pass) {
+        order[num_ordered++] = i;
+      }
+    }
+  }
+
+  int original_alpha = alpha;
+  int best = -kInfinity;
+  unsigned best_index = 0;
+
+  for (unsigned i = 0; i < num_ordered; i++) {
+    player.ApplyMove(moves[order[i]], tree.table, tree.journal);
+    int value = -Solve(tree, transpositions, turn ^ 1, -beta, -alpha, budget,
+        nullptr);
+    player.UndoMove(tree.table, tree.journal);
+
+    if (!budget) {
+      return 0;
+    }
+
+    if (value > best) {
+      best = value;
+      best_index = order[i];
+    }
+
+    if (best > alpha) {
+      alpha = best;
+    }
+
+    if (alpha >= beta) {
+      break;
+    }
+  }
+
+  if (best_move) {
+    *best_move = moves[best_index];
+  }
+
+  entry.value = best;
+  entry.bound = (best <= original_alpha ? TranspositionTable::kUpper :
+      best >= beta ? TranspositionTable::kLower : TranspositionTable::kExact);
+  entry.depth = depth;
+  entry.move_index = (best_index < 0xff ? best_index : 0xff);
+  transpositions.Store(key, entry);
+
+  return best;
+}
+
+/**
+ * Description: Scores a finished round as a point margin. Like
+ *     Round::FinishRound, which scores before clearing the table, the loose
+ *     cards left over count for no one.
+ * Parameters: const Tree& tree: The tree, with its game at the end of a round.
+ * const unsigned& turn: The number of the player to score for.
+ * Returns: The player's points minus the opponent's.
+ */
+
+int MonteCarloSearch::GetMargin(const Tree& tree, const unsigned& turn) {
+  PileTally piles[2];
+  unsigned points[2];
+
+  for (unsigned i = 0; i < 2; i++) {
+    piles[i] = tree.players[i]->GetPileTally();
+  }
+
+  Round::ScorePiles(piles, points);
+
+  return (int) points[turn] - (int) points[turn ^ 1];
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+#ifndef _MONTE_CARLO_SEARCH_H_
+#define _MONTE_CARLO_SEARCH_H_
+
+#include <chrono>
+#include <vector>
+#include "player.h"
+#include "movegenerator.h"
+#include "movejournal.h"
+#include "random.h"
+#include "transpositiontable.h"
+
+// Determinized Monte Carlo tree search (information set UCT). Every
+// iteration deals the unseen cards into a random opponent hand and deck,
+// walks one shared tree of moves, plays the round out and scores it. Each
+// thread grows its own tree and the root visit counts are summed. Once the
+// deck is gone nothing is hidden, and the rest of the round is solved
+// exactly with alpha-beta over a transposition table instead.
+class MonteCarloSearch {
+ public:
+  // Public structs
+  struct Config {
+    unsigned millis;
+    unsigned iterations;
+    unsigned num_threads;
+    double exploration;
+    std::shared_ptr<TranspositionTable> transpositions;
+  };
+
+  // Public constants
+  static const Config kDefaultConfig;
+
+  // Delete copy constructor and assignment operator
+  MonteCarloSearch(const MonteCarloSearch& search) = delete;
+  MonteCarloSearch& operator=(const MonteCarloSearch& search) = delete;
+
+  // Constructors
+  MonteCarloSearch(const Config& config) : config_(config),
+      num_iterations_(0) {}
+
+  // Accessors
+  inline unsigned long GetNumIterations() const { return num_iterations_; }
+
+  // Public utils
+  Move Search(const Player& self, const Player& opponent,
+      const std::shared_ptr<Table>& table, const unsigned& deck_size,
+      const uint64_t& seed);
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  // Private structs
+  struct Root {
+    unsigned self_number;
+    std::vector<Card> hand;
+    uint64_t piles[2];
+    std::vector<Card> loose_cards;
+    std::vector<std::shared_ptr<Build>> builds;
+    unsigned last_captured_index;
+    unsigned opponent_hand_size;
+    unsigned deck_size;
+    std::vector<Card> unseen;
+  };
+
+  struct Node {
+    Move move;
+    unsigned mover;
+    unsigned parent;
+    unsigned first_child;
+    unsigned next_sibling;
+    unsigned visits;
+    unsigned avails;
+    double reward;
+  };
+
+  struct Tree {
+    const Root& root;
+    const Config& config;
+    Random rng;
+    std::vector<Node> nodes;
+    std::shared_ptr<Player> players[2];
+    std::shared_ptr<Table> table;
+    std::vector<Card> deck;
+    unsigned deck_index;
+    MoveGenerator generator;
+    MoveList moves;
+    MoveJournal journal;
+    std::vector<unsigned> path;
+    std::vector<unsigned> steps;
+    unsigned long num_iterations;
+
+    Tree(const Root& root, const Config& config, const uint64_t& seed);
+  };
+
+  // Private constants
+  static const unsigned kNoNode = ~0U;
+  static const unsigned kDealStep = 2;
+  static const unsigned kIterationsPerClockCheck = 16;
+  static const unsigned long kMaxSolverNodes = 200000;
+  static const unsigned kSolverTableBits = 16;
+  static const int kInfinity = 100;
+
+  Config config_;
+  unsigned long num_iterations_;
+
+  // Private utils
+  static void Grow(Tree& tree, const Clock::time_point& deadline,
+      const unsigned long& max_iterations);
+
+  static void Iterate(Tree& tree);
+  static void Determinize(Tree& tree);
+  static unsigned SelectOrExpand(Tree& tree, const unsigned& node,
+      const unsigned& mover, Move& move, bool& expanded);
+
+  static const Move& PickRolloutMove(Tree& tree);
+  static double Evaluate(const Tree& tree);
+  static bool IsSameMove(const Move& one, const Move& two);
+
+  static bool SolveEndgame(Tree& tree, TranspositionTable& transpositions,
+      Move& move);
+
+  static int Solve(Tree& tree, TranspositionTable& transpositions,
+      const unsigned& turn, int alpha, const int& beta,
+      unsigned long& budget, Move* best_move);
+
+  static int GetMargin(const Tree& tree, const unsigned& turn);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,32 @@
+#include "move.h"
+#include "bitboard.h"
+
+/**
+ * Description: Describes the move as a string.
+ * Parameters: None.
+ * Returns: The string format of the move.
+ */
+
+std::string Move::ToString() const {
+  const char* names[] = {"", "Trail", "Make", "Add", "Increase", "Capture"};
+  std::string str = names[type];
+  str += ' ' + card.ToString();
+
+  for (unsigned id = 0; id < Card::kNumCards; id++) {
+    if (loose_mask & (1ULL << id)) {
+      str += ' ' + Card::FromId(id).ToString();
+    }
+  }
+
+  if (type == kAdd || type == kIncrease) {
+    str += " build " + std::to_string(build_index);
+  }
+
+  for (unsigned i = 0; i < 32; i++) {
+    if (build_mask & (1U << i)) {
+      str += " build " + std::to_string(i);
+    }
+  }
+
+  return str;
+}
\ No newline at end of file
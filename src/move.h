@@ -0,0 +1,82 @@
+#ifndef _MOVE_H_
+#define _MOVE_H_
+
+#include <cstdint>
+#include <string>
+#include "card.h"
+
+// One legal move in 16 bytes. Loose cards are a Bitboard of card ids and
+// captured builds a mask of positions in the table's current builds.
+struct Move {
+  // Public enums
+  enum Type {
+    kTrail = 1,
+    kMake,
+    kAdd,
+    kIncrease,
+    kCapture
+  };
+
+  uint8_t type;
+  uint8_t card_index;
+  Card card;
+  uint8_t build_index;
+  uint32_t build_mask;
+  uint64_t loose_mask;
+
+  // Public utils
+  inline bool operator==(const Move& move) const {
+    return type == move.type && card_index == move.card_index &&
+        build_index == move.build_index && build_mask == move.build_mask &&
+        loose_mask == move.loose_mask;
+  }
+
+  std::string ToString() const;
+};
+
+// A fixed-capacity list of moves that never allocates.
+class MoveList {
+ public:
+  // Public constants
+  static const unsigned kMaxMoves = 1024;
+
+  // Constructors
+  MoveList() : size_(0), is_truncated_(false) {}
+
+  // Accessors
+  inline unsigned GetSize() const { return size_; }
+  inline bool IsEmpty() const { return !size_; }
+  inline bool IsTruncated() const { return is_truncated_; }
+  inline const Move& operator[](const unsigned& index) const {
+    return moves_[index];
+  }
+
+  // Mutators
+  // For a generator that had to leave moves out
+  inline void SetIsTruncated() { is_truncated_ = true; }
+
+  // Public utils
+  inline void Clear() {
+    size_ = 0;
+    is_truncated_ = false;
+  }
+
+  // Drops the move and marks the list truncated once it is full
+  inline bool Add(const Move& move) {
+    if (size_ == kMaxMoves) {
+      is_truncated_ = true;
+      return false;
+    }
+
+    moves_[size_++] = move;
+
+    return true;
+  }
+
+ private:
+  Move moves_[kMaxMoves];
+  unsigned size_;
+  bool is_truncated_;
+};
+
+#endif
\ No newline at end of file
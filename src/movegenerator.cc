@@ -0,0 +1,276 @@
+#include "movegenerator.h"
+
+/**
+ * Description: Lists every legal move of a hand. A card that matches a loose
+ *     card or one of the player's builds may only capture, and trailing is
+ *     not allowed while the player owns a build, unless nothing else is
+ *     legal. A capture takes every matching loose card and build along with
+ *     any disjoint sets.
+ * Parameters: const std::vector<Card>& hand: The cards in hand.
+ * const unsigned& number: The number of the player to move.
+ * const std::shared_ptr<Table>& table: The current table state.
+ * MoveList& moves: An input parameter to fill out with the moves.
+ * Returns: Nothing.
+ */
+
+void MoveGenerator::Generate(
+    const std::vector<Card>& hand, const unsigned& number,
+    const std::shared_ptr<Table>& table, MoveList& moves) {
+  const auto& loose_cards = table->GetLooseCards();
+  const auto& builds = table->GetCurrentBuilds();
+  bool can_trail = CanTrail(number, table);
+  moves.Clear();
+
+  for (unsigned i = 0; i < hand.size(); i++) {
+    AddCaptures(hand, i, loose_cards, builds, table, moves);
+
+    if (MustCapture(hand[i], number, table)) {
+      continue;
+    }
+
+    if (!table->TableEmpty()) {
+      AddBuilds(hand, i, number, loose_cards, builds, moves);
+    }
+
+    if (can_trail) {
+      moves.Add(StartMove(Move::kTrail, hand, i));
+    }
+  }
+
+  // A player who gave up the card for their build is stuck, so let them trail
+  if (moves.IsEmpty()) {
+    for (unsigned i = 0; i < hand.size(); i++) {
+      moves.Add(StartMove(Move::kTrail, hand, i));
+    }
+  }
+}
+
+/**
+ * Description: Lists every legal move of a hand with a generator and list
+ *     kept per thread, so checking one move allocates nothing.
+ * Parameters: const std::vector<Card>& hand: The cards in hand.
+ * const unsigned& number: The number of the player to move.
+ * const std::shared_ptr<Table>& table: The current table state.
+ * Returns: The moves, valid until the thread's next call.
+ */
+
+const MoveList& MoveGenerator::GenerateOnThread(
+    const std::vector<Card>& hand, const unsigned& number,
+    const std::shared_ptr<Table>& table) {
+  static thread_local MoveGenerator generator;
+  static thread_local MoveList moves;
+  generator.Generate(hand, number, table, moves);
+
+  return moves;
+}
+
+/**
+ * Description: Checks if a card has to be used to capture.
+ * Parameters: const Card& card: The played card.
+ * const unsigned& number: The number of the player to move.
+ * const std::shared_ptr<Table>& table: The current table state.
+ * Returns: Whether the card matches a loose card or one of the player's
+ *     builds, counting an ace as fourteen too.
+ */
+
+bool MoveGenerator::MustCapture(
+    const Card& card, const unsigned& number,
+    const std::shared_ptr<Table>& table) {
+  return table->ValueMatchesBuild(card.GetValue(), number) ||
+      (card.IsAce() && table->ValueMatchesBuild(Card::kAceTwo, number)) ||
+      table->ValueMatchesLooseCard(card.GetValue());
+}
+
+/**
+ * Description: Checks if the player may trail.
+ * Parameters: const unsigned& number: The number of the player to move.
+ * const std::shared_ptr<Table>& table: The current table state.
+ * Returns: Whether the player owns no builds.
+ */
+
+bool MoveGenerator::CanTrail(
+    const unsigned& number, const std::shared_ptr<Table>& table) {
+  return !table->PlayerOwnsAnyBuilds(number);
+}
+
+/**
+ * Description: Gets the build sums the rest of the hand could capture.
+ * Parameters: const std::vector<Card>& hand: The cards in hand.
+ * const unsigned& card_index: The index of the played card.
+ * Returns: A mask with bit s set when a build of sum s could be captured.
+ */
+
+uint32_t MoveGenerator::GetBuildableSums(
+    const std::vector<Card>& hand, const unsigned& card_index) {
+  uint32_t sums = 0;
+
+  for (unsigned i = 0; i < hand.size(); i++) {
+    if (card_index == i) {
+      continue;
+    }
+
+    if (hand[i].IsAce()) {
+      sums |= SubsetSum::SumToMask(Card::kAceTwo);
+    }
+
+    sums |= SubsetSum::SumToMask(hand[i].GetValue());
+  }
+
+  return sums;
+}
+
+/**
+ * Description: Converts positions in a card vector to a set of cards.
+ * Parameters: const std::vector<Card>& cards: The cards.
+ * const uint64_t& positions: Bit i is set for cards[i].
+ * Returns: The Bitboard of the chosen cards.
+ */
+
+uint64_t MoveGenerator::ToCardMask(
+    const std::vector<Card>& cards, const uint64_t& positions) {
+  uint64_t mask = Bitboard::kEmpty;
+  uint64_t rest = positions;
+
+  while (rest) {
+    mask |= Bitboard::FromCard(cards[__builtin_ctzll(rest)]);
+    rest &= rest - 1;
+  }
+
+  return mask;
+}
+
+/**
+ * Description: Adds the captures of one card, as many as the list has room
+ *     for.
+ * Parameters: const std::vector<Card>& hand: The cards in hand.
+ * const unsigned& card_index: The index of the played card.
+ * const std::vector<Card>& loose_cards: The loose cards on the table.
+ * const std::vector<std::shared_ptr<Build>>& builds: The builds on the table.
+ * const std::shared_ptr<Table>& table: The current table state.
+ * MoveList& moves: The list to add to.
+ * Returns: Nothing.
+ */
+
+void MoveGenerator::AddCaptures(
+    const std::vector<Card>& hand, const unsigned& card_index,
+    const std::vector<Card>& loose_cards,
+    const std::vector<std::shared_ptr<Build>>& builds,
+    const std::shared_ptr<Table>& table, MoveList& moves) {
+  Card card = hand[card_index];
+  uint32_t targets = SubsetSum::SumToMask(card.GetValue());
+
+  if (card.IsAce()) {
+    targets |= SubsetSum::SumToMask(Card::kAceTwo);
+  }
+
+  Move move = StartMove(Move::kCapture, hand, card_index);
+  uint64_t matches =
+      table->GetLooseMask() & Bitboard::FromValue(card.GetValue());
+
+  for (unsigned i = 0; i < builds.size(); i++) {
+    if (SubsetSum::SumToMask(builds[i]->GetBuildSum()) & targets) {
+      move.build_mask |= 1U << i;
+    }
+  }
+
+  // Each union gives at most one move, so only as many are found as the list
+  // has room for
+  SubsetSum::FindSubsets(loose_cards, 0, targets, 2, subsets_);
+
+  if (!SubsetSum::FindDisjointUnions(
+      subsets_, MoveList::kMaxMoves - moves.GetSize(), unions_)) {
+    moves.SetIsTruncated();
+  }
+
+  // Distinct unions give distinct captures, except when an ace's set takes
+  // an ace, which it captures anyway; no other card's sets can take a card
+  // of its own value
+  if (card.IsAce()) {
+    captures_.Reset(unions_.size());
+  }
+
+  for (unsigned i = 0; i < unions_.size(); i++) {
+    move.loose_mask = ToCardMask(loose_cards, unions_[i]) | matches;
+
+    if ((move.loose_mask == Bitboard::kEmpty && !move.build_mask) ||
+        (card.IsAce() && !captures_.Insert(move.loose_mask))) {
+      continue;
+    }
+
+    moves.Add(move);
+  }
+}
+
+/**
+ * Description: Adds the builds one card can make, add to or increase.
+ * Parameters: const std::vector<Card>& hand: The cards in hand.
+ * const unsigned& card_index: The index of the played card.
+ * const unsigned& number: The number of the player to move.
+ * const std::vector<Card>& loose_cards: The loose cards on the table.
+ * const std::vector<std::shared_ptr<Build>>& builds: The builds on the table.
+ * MoveList& moves: The list to add to.
+ * Returns: Nothing.
+ */
+
+void MoveGenerator::AddBuilds(
+    const std::vector<Card>& hand, const unsigned& card_index,
+    const unsigned& number, const std::vector<Card>& loose_cards,
+    const std::vector<std::shared_ptr<Build>>& builds, MoveList& moves) {
+  unsigned value = hand[card_index].GetValue();
+  uint32_t buildable_sums = GetBuildableSums(hand, card_index);
+  Move move = StartMove(Move::kMake, hand, card_index);
+  SubsetSum::FindSubsets(loose_cards, value, buildable_sums, 1, subsets_);
+
+  for (unsigned i = 0; i < subsets_.size(); i++) {
+    move.loose_mask = ToCardMask(loose_cards, subsets_[i]);
+    moves.Add(move);
+  }
+
+  for (unsigned i = 0; i < builds.size(); i++) {
+    unsigned build_sum = builds[i]->GetBuildSum();
+    uint32_t target = SubsetSum::SumToMask(build_sum) & buildable_sums;
+
+    if (target) {
+      move = StartMove(Move::kAdd, hand, card_index);
+      move.build_index = i;
+      SubsetSum::FindSubsets(loose_cards, value, target, 0, subsets_);
+
+      for (unsigned j = 0; j < subsets_.size(); j++) {
+        move.loose_mask = ToCardMask(loose_cards, subsets_[j]);
+        moves.Add(move);
+      }
+    }
+
+    if (builds[i]->GetOwnerIndex() == number || builds[i]->IsMultipleBuild()) {
+      continue;
+    }
+
+    if (SubsetSum::SumToMask(value + build_sum) & buildable_sums) {
+      move = StartMove(Move::kIncrease, hand, card_index);
+      move.build_index = i;
+      moves.Add(move);
+    }
+  }
+}
+
+/**
+ * Description: Starts a move that plays the given card.
+ * Parameters: const unsigned& type: The type of move.
+ * const std::vector<Card>& hand: The cards in hand.
+ * const unsigned& card_index: The index of the played card.
+ * Returns: The move, with no cards or builds chosen yet.
+ */
+
+Move MoveGenerator::StartMove(
+    const unsigned& type, const std::vector<Card>& hand,
+    const unsigned& card_index) {
+  Move move;
+  move.type = type;
+  move.card_index = card_index;
+  move.card = hand[card_index];
+  move.build_index = 0;
+  move.build_mask = 0;
+  move.loose_mask = Bitboard::kEmpty;
+
+  return move;
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#ifndef _MOVE_GENERATOR_H_
+#define _MOVE_GENERATOR_H_
+
+#include <vector>
+#include "arena.h"
+#include "move.h"
+#include "subsetsum.h"
+#include "table.h"
+
+// Lists every legal move for a hand. The rule checks are shared with the
+// interactive validation in Human so both agree on what is legal.
+class MoveGenerator {
+ public:
+  // Delete copy constructor and assignment operator
+  MoveGenerator(const MoveGenerator& move_generator) = delete;
+  MoveGenerator& operator=(const MoveGenerator& move_generator) = delete;
+
+  // Constructors
+  MoveGenerator() = default;
+
+  // Public utils
+  void Generate(const std::vector<Card>& hand, const unsigned& number,
+      const std::shared_ptr<Table>& table, MoveList& moves);
+
+  // Generates into the thread's own list, for a caller checking a single
+  // move. The list holds until the thread's next call
+  static const MoveList& GenerateOnThread(const std::vector<Card>& hand,
+      const unsigned& number, const std::shared_ptr<Table>& table);
+
+  static bool MustCapture(const Card& card, const unsigned& number,
+      const std::shared_ptr<Table>& table);
+
+  static bool CanTrail(const unsigned& number,
+      const std::shared_ptr<Table>& table);
+
+  static uint32_t GetBuildableSums(const std::vector<Card>& hand,
+      const unsigned& card_index);
+
+  static uint64_t ToCardMask(const std::vector<Card>& cards,
+      const uint64_t& positions);
+
+ private:
+  // Scratch space reused between calls
+  ScratchVector<uint64_t> subsets_;
+  ScratchVector<uint64_t> unions_;
+  MaskSet captures_;
+
+  // Private utils
+  void AddCaptures(const std::vector<Card>& hand, const unsigned& card_index,
+      const std::vector<Card>& loose_cards,
+      const std::vector<std::shared_ptr<Build>>& builds,
+      const std::shared_ptr<Table>& table, MoveList& moves);
+
+  void AddBuilds(const std::vector<Card>& hand, const unsigned& card_index,
+      const unsigned& number, const std::vector<Card>& loose_cards,
+      const std::vector<std::shared_ptr<Build>>& builds, MoveList& moves);
+
+  static Move StartMove(const unsigned& type, const std::vector<Card>& hand,
+      const unsigned& card_index);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,47 @@
+#include "movejournal.h"
+
+/**
+ * Description: Constructs an empty journal with room for a deep search.
+ * Parameters: None.
+ * Returns: Nothing.
+ */
+
+MoveJournal::MoveJournal() {
+  entries_.reserve(kInitialDepth);
+  loose_cards_.reserve(kInitialDepth * Card::kNumSuits);
+  builds_.reserve(kInitialDepth);
+  spare_builds_.reserve(kInitialDepth);
+  scratch_.reserve(Card::kNumCards);
+}
+
+/**
+ * Description: Gets an empty build, reusing one that was taken back if there
+ *     is one.
+ * Parameters: None.
+ * Returns: The build.
+ */
+
+std::shared_ptr<Build> MoveJournal::NewBuild() {
+  if (spare_builds_.empty()) {
+    return std::shared_ptr<Build>(new Build);
+  }
+
+  std::shared_ptr<Build> build = spare_builds_.back();
+  spare_builds_.pop_back();
+  build->Clear();
+
+  return build;
+}
+
+/**
+ * Description: Keeps a build that was taken off the table for reuse, unless
+ *     something else still holds it.
+ * Parameters: const std::shared_ptr<Build>& build: The build.
+ * Returns: Nothing.
+ */
+
+void MoveJournal::RecycleBuild(const std::shared_ptr<Build>& build) {
+  if (build.use_count() == 1) {
+    spare_builds_.push_back(build);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#ifndef _MOVE_JOURNAL_H_
+#define _MOVE_JOURNAL_H_
+
+#include <memory>
+#include <vector>
+#include "move.h"
+#include "build.h"
+
+// A stack of undo records for Player::ApplyMove and Player::UndoMove. Each
+// record is a few bytes; the loose cards and builds a move removed are kept
+// on side stacks, and builds taken off the table are recycled, so a search
+// that reuses one journal stops allocating once it has warmed up.
+class MoveJournal {
+ public:
+  // Public structs
+  struct Entry {
+    Move move;
+    uint64_t loose_positions;
+    uint32_t build_positions;
+    uint8_t pile_size;
+    uint8_t last_captured_index;
+    uint8_t build_sum;
+    uint8_t build_owner;
+  };
+
+  // Delete copy constructor and assignment operator
+  MoveJournal(const MoveJournal& move_journal) = delete;
+  MoveJournal& operator=(const MoveJournal& move_journal) = delete;
+
+  // Constructors
+  MoveJournal();
+
+  // Accessors
+  inline unsigned GetDepth() const { return entries_.size(); }
+  inline bool IsEmpty() const { return entries_.empty(); }
+  inline const Entry& Top() const { return entries_.back(); }
+
+  // Public utils
+  inline void Push(const Entry& entry) { entries_.push_back(entry); }
+  inline void Pop() { entries_.pop_back(); }
+  inline void Clear() {
+    entries_.clear();
+    loose_cards_.clear();
+    builds_.clear();
+  }
+
+  inline void SaveLooseCard(const Card& card) { loose_cards_.push_back(card); }
+  inline void SaveBuild(const std::shared_ptr<Build>& build) {
+    builds_.push_back(build);
+  }
+
+  // The last saved cards or builds, in the order they were saved
+  inline const Card* GetSavedLooseCards(const unsigned& num_cards) const {
+    return loose_cards_.data() + loose_cards_.size() - num_cards;
+  }
+
+  inline const std::shared_ptr<Build>* GetSavedBuilds(
+      const unsigned& num_builds) const {
+    return builds_.data() + builds_.size() - num_builds;
+  }
+
+  inline void DropSavedLooseCards(const unsigned& num_cards) {
+    loose_cards_.resize(loose_cards_.size() - num_cards);
+  }
+
+  inline void DropSavedBuilds(const unsigned& num_builds) {
+    builds_.resize(builds_.size() - num_builds);
+  }
+
+  std::shared_ptr<Build> NewBuild();
+  void RecycleBuild(const std::shared_ptr<Build>& build);
+  inline std::vector<Card>& GetScratch() {
+    scratch_.clear();
+
+    return scratch_;
+  }
+
+ private:
+  // Private constants
+  static const unsigned kInitialDepth = 64;
+
+  std::vector<Entry> entries_;
+  std::vector<Card> loose_cards_;
+  std::vector<std::shared_ptr<Build>> builds_;
+  std::vector<std::shared_ptr<Build>> spare_builds_;
+  std::vector<Card> scratch_;
+};
+
+#endif
\ No newline at end of file
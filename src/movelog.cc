@@ -0,0 +1,357 @@
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "movelog.h"
+
+static_assert(sizeof(MoveLog::Record) == 40, "move log records are 40 bytes");
+static_assert(MoveLog::kHeaderSize % 4096 == 0, "segments must be page aligned");
+
+const char MoveLog::kMagic[] = "CSMOVLOG";
+const uint64_t MoveLog::kUnclosed;
+
+/**
+ * Description: Opens a log for appending, creating it if needed. Records
+ *     already in the file are kept; if the log was never closed, appending
+ *     resumes after every slot it had grown to.
+ * Parameters: const std::string& file_name: The log file.
+ * Returns: Nothing.
+ */
+
+MoveLog::MoveLog(const std::string& file_name) :
+    fd_(open(file_name.c_str(), O_RDWR | O_CREAT, 0644)), file_size_(0),
+    next_(0), segments_(new std::atomic<Record*>[kMaxSegments]) {
+  for (unsigned i = 0; i < kMaxSegments; i++) {
+    segments_[i].store(nullptr);
+  }
+
+  struct stat status;
+
+  if (fd_ < 0 || fstat(fd_, &status)) {
+    Close();
+    return;
+  }
+
+  Header header;
+  file_size_ = status.st_size;
+
+  if (file_size_ >= sizeof(header)) {
+    if (pread(fd_, &header, sizeof(header), 0) != sizeof(header) ||
+        memcmp(header.magic, kMagic, sizeof(header.magic)) ||
+        header.record_size != sizeof(Record)) {
+      Close();
+      return;
+    }
+
+    next_ = (header.num_records != kUnclosed ? header.num_records :
+        (file_size_ - kHeaderSize) / sizeof(Record));
+  }
+
+  if (!WriteHeader(kUnclosed)) {
+    Close();
+  }
+}
+
+/**
+ * Description: Closes the log.
+ * Parameters: None.
+ * Returns: Nothing.
+ */
+
+MoveLog::~MoveLog() {
+  Close();
+}
+
+/**
+ * Description: Appends one record. Safe to call from any number of threads.
+ * Parameters: const uint64_t& game_id: The game the move was played in.
+ * const uint32_t& ply: The move's number within the game, from zero.
+ * const Move& move: The move.
+ * const uint64_t& hash: The position's hash after the move.
+ * Returns: Whether the record was written.
+ */
+
+bool MoveLog::Append(
+    const uint64_t& game_id, const uint32_t& ply, const Move& move,
+    const uint64_t& hash) {
+  if (!IsOpen()) {
+    return false;
+  }
+
+  uint64_t index = next_.fetch_add(1, std::memory_order_relaxed);
+  Record* segment = GetSegment(index);
+
+  if (!segment) {
+    return false;
+  }
+
+  Record& record = segment[index % kRecordsPerSegment];
+  record.game_id = game_id;
+  record.ply = ply;
+  record.move = move;
+  record.hash = hash;
+  __atomic_store_n(&record.commit, kCommitted, __ATOMIC_RELEASE);
+
+  return true;
+}
+
+/**
+ * Description: Unmaps the log, trims the unused end of its last segment and
+ *     records how many slots it holds. Every Append must have returned.
+ * Parameters: None.
+ * Returns: Nothing.
+ */
+
+void MoveLog::Close() {
+  if (fd_ < 0) {
+    return;
+  }
+
+  for (unsigned i = 0; i < kMaxSegments; i++) {
+    Record* segment = segments_[i].exchange(nullptr);
+
+    if (segment) {
+      munmap(segment, kSegmentSize);
+    }
+  }
+
+  uint64_t num_records = next_.load();
+
+  if (!ftruncate(fd_, kHeaderSize + num_records * sizeof(Record))) {
+    WriteHeader(num_records);
+  }
+
+  close(fd_);
+  fd_ = -1;
+}
+
+/**
+ * Description: Gets the mapped segment holding a slot, growing the file and
+ *     mapping the segment the first time it is needed.
+ * Parameters: const uint64_t& index: The slot.
+ * Returns: The segment, or null if it could not be mapped.
+ */
+
+MoveLog::Record* MoveLog::GetSegment(const uint64_t& index) {
+  uint64_t number = index / kRecordsPerSegment;
+
+  if (number >= kMaxSegments) {
+    return nullptr;
+  }
+
+  Record* segment = segments_[number].load(std::memory_order_acquire);
+
+  if (segment) {
+    return segment;
+  }
+
+  std::lock_guard<std::mutex> lock(grow_mutex_);
+  segment = segments_[number].load(std::memory_order_relaxed);
+
+  if (segment) {
+    return segment;
+  }
+
+  uint64_t offset = kHeaderSize + number * kSegmentSize;
+
+  if (file_size_ < offset + kSegmentSize) {
+    if (ftruncate(fd_, offset + kSegmentSize)) {
+      return nullptr;
+    }
+
+    file_size_ = offset + kSegmentSize;
+  }
+
+  void* mapping = mmap(nullptr, kSegmentSize, PROT_READ | PROT_WRITE,
+      MAP_SHARED, fd_, offset);
+
+  if (mapping == MAP_FAILED) {
+    return nullptr;
+  }
+
+  segment = (Record*) mapping;
+  segments_[number].store(segment, std::memory_order_release);
+
+  return segment;
+}
+
+/**
+ * Description: Writes the file header.
+ * Parameters: const uint64_t& num_records: The number of slots, or kUnclosed
+ *     while the log is open.
+ * Returns: Whether the header was written.
+ */
+
+bool MoveLog::WriteHeader(const uint64_t& num_records) {
+  Header header;
+  memcpy(header.magic, kMagic, sizeof(header.magic));
+  header.version = kVersion;
+  header.record_size = sizeof(Record);
+  header.num_records = num_records;
+
+  if (file_size_ < kHeaderSize) {
+    if (ftruncate(fd_, kHeaderSize)) {
+      return false;
+    }
+
+    file_size_ = kHeaderSize;
+  }
+
+  return pwrite(fd_, &header, sizeof(header), 0) == sizeof(header);
+}
+
+/**
+ * Description: Saves what GetPlayedMove needs to work out a move made through
+ *     MakeMove rather than ApplyMove.
+ * Parameters: const Player& player: The player about to move.
+ * const Table& table: The table.
+ * Before& before: An input parameter set to the state before the move.
+ * Returns: Nothing.
+ */
+
+void MoveLog::SaveBefore(
+    const Player& player, const Table& table, Before& before) {
+  before.hand = player.GetHand();
+  before.pile_mask = player.GetPileMask();
+  before.loose_mask = table.GetLooseMask();
+  before.builds.clear();
+  before.build_hashes.clear();
+  before.build_sizes.clear();
+
+  for (unsigned i = 0; i < table.GetNumBuilds(); i++) {
+    before.builds.push_back(table.GetBuild(i));
+    before.build_hashes.push_back(table.GetBuild(i)->GetHash());
+    before.build_sizes.push_back(table.GetBuild(i)->GetBuildSize());
+  }
+}
+
+/**
+ * Description: Works out the move a player just made, in the form ApplyMove
+ *     plays it.
+ * Parameters: const Before& before: The state saved before the move.
+ * const Player& player: The player who moved.
+ * const Table& table: The table after the move.
+ * Returns: The move.
+ */
+
+Move MoveLog::GetPlayedMove(
+    const Before& before, const Player& player, const Table& table) {
+  Move move = Move();
+  uint64_t hand_mask = player.GetHandMask();
+
+  while (move.card_index < before.hand.size() &&
+      Bitboard::Contains(hand_mask, before.hand[move.card_index])) {
+    move.card_index++;
+  }
+
+  move.card = before.hand[move.card_index];
+  move.loose_mask = before.loose_mask & ~table.GetLooseMask();
+
+  if (player.GetPileMask() != before.pile_mask) {
+    move.type = Move::kCapture;
+
+    for (unsigned i = 0, j = 0; i < before.builds.size(); i++) {
+      if (j < table.GetNumBuilds() && table.GetBuild(j) == before.builds[i]) {
+        j++;
+      } else {
+        move.build_mask |= 1U << i;
+      }
+    }
+  } else if (Bitboard::Contains(table.GetLooseMask(), move.card)) {
+    move.type = Move::kTrail;
+  } else if (table.GetNumBuilds() > before.builds.size()) {
+    move.type = Move::kMake;
+  } else {
+    while (move.build_index < before.builds.size() &&
+        before.builds[move.build_index]->GetHash() ==
+        before.build_hashes[move.build_index]) {
+      move.build_index++;
+    }
+
+    move.type = (before.builds[move.build_index]->GetBuildSize() >
+        before.build_sizes[move.build_index] ? Move::kAdd : Move::kIncrease);
+  }
+
+  return move;
+}
+
+/**
+ * Description: Opens a log for reading.
+ * Parameters: const std::string& file_name: The log file.
+ * Returns: Nothing.
+ */
+
+MoveLogReader::MoveLogReader(const std::string& file_name) :
+    mapping_(MAP_FAILED), mapping_size_(0), records_(nullptr),
+    num_slots_(0), index_(0) {
+  int fd = open(file_name.c_str(), O_RDONLY);
+  struct stat status;
+
+  if (fd < 0) {
+    return;
+  }
+
+  if (fstat(fd, &status) || (uint64_t) status.st_size < MoveLog::kHeaderSize) {
+    close(fd);
+    return;
+  }
+
+  mapping_size_ = status.st_size;
+  mapping_ = mmap(nullptr, mapping_size_, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+
+  if (mapping_ == MAP_FAILED) {
+    return;
+  }
+
+  const MoveLog::Header* header = (const MoveLog::Header*) mapping_;
+
+  if (memcmp(header->magic, MoveLog::kMagic, sizeof(header->magic)) ||
+      header->record_size != sizeof(MoveLog::Record)) {
+    return;
+  }
+
+  madvise(mapping_, mapping_size_, MADV_SEQUENTIAL);
+  records_ = (const MoveLog::Record*) ((const char*) mapping_ +
+      MoveLog::kHeaderSize);
+  num_slots_ = (mapping_size_ - MoveLog::kHeaderSize) /
+      sizeof(MoveLog::Record);
+
+  if (header->num_records != MoveLog::kUnclosed &&
+      header->num_records < num_slots_) {
+    num_slots_ = header->num_records;
+  }
+}
+
+/**
+ * Description: Unmaps the log.
+ * Parameters: None.
+ * Returns: Nothing.
+ */
+
+MoveLogReader::~MoveLogReader() {
+  if (mapping_ != MAP_FAILED) {
+    munmap(mapping_, mapping_size_);
+  }
+}
+
+/**
+ * Description: Reads the next committed record.
+ * Parameters: MoveLog::Record& record: An input parameter set to the record.
+ * Returns: Whether there was one before the end of the log.
+ */
+
+bool MoveLogReader::Next(MoveLog::Record& record) {
+  while (index_ < num_slots_) {
+    const MoveLog::Record& slot = records_[index_++];
+
+    if (__atomic_load_n(&slot.commit, __ATOMIC_ACQUIRE) ==
+        MoveLog::kCommitted) {
+      record = slot;
+      return true;
+    }
+  }
+
+  return false;
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+#ifndef _MOVE_LOG_H_
+#define _MOVE_LOG_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "move.h"
+#include "player.h"
+
+// An append-only file of fixed-size move records, written through memory
+// mappings. Writers on any number of threads claim a slot with one atomic
+// add and fill it in place; the file grows one mapped segment at a time. A
+// slot only counts once its commit word is set, so readers never see half a
+// record, even in a log left behind by a crash.
+class MoveLog {
+ public:
+  // Public structs
+  struct Record {
+    uint64_t game_id;
+    uint32_t ply;
+    uint32_t commit;
+    Move move;
+    uint64_t hash;
+  };
+
+  // What a move is worked out from: the mover's hand and the table before it
+  struct Before {
+    std::vector<Card> hand;
+    uint64_t pile_mask;
+    uint64_t loose_mask;
+    std::vector<std::shared_ptr<Build>> builds;
+    std::vector<uint64_t> build_hashes;
+    std::vector<unsigned> build_sizes;
+  };
+
+  // Public constants
+  static const uint32_t kCommitted = 0x45564f4d;
+  static const unsigned kHeaderSize = 4096;
+
+  // Delete copy constructor and assignment operator
+  MoveLog(const MoveLog& move_log) = delete;
+  MoveLog& operator=(const MoveLog& move_log) = delete;
+
+  // Constructors
+  MoveLog(const std::string& file_name);
+  ~MoveLog();
+
+  // Accessors
+  inline bool IsOpen() const { return fd_ >= 0; }
+  inline uint64_t GetNumRecords() const { return next_.load(); }
+
+  // Public utils
+  bool Append(const uint64_t& game_id, const uint32_t& ply, const Move& move,
+      const uint64_t& hash);
+
+  void Close();
+  static void SaveBefore(const Player& player, const Table& table,
+      Before& before);
+
+  static Move GetPlayedMove(const Before& before, const Player& player,
+      const Table& table);
+
+ private:
+  // Private structs
+  struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t num_records;
+  };
+
+  // Private constants
+  static const char kMagic[];
+  static const uint32_t kVersion = 1;
+  static const uint64_t kUnclosed = ~0ULL;
+  static const unsigned kRecordsPerSegment = 1 << 16;
+  static const unsigned kMaxSegments = 1 << 16;
+  static const uint64_t kSegmentSize = kRecordsPerSegment * sizeof(Record);
+
+  int fd_;
+  uint64_t file_size_;
+  std::atomic<uint64_t> next_;
+  std::unique_ptr<std::atomic<Record*>[]> segments_;
+  std::mutex grow_mutex_;
+
+  // Private utils
+  Record* GetSegment(const uint64_t& index);
+  bool WriteHeader(const uint64_t& num_records);
+
+  friend class MoveLogReader;
+};
+
+// Streams the records of a move log in file order, skipping slots that were
+// never committed. The file is mapped rather than read, so only the pages
+// being looked at are in memory.
+class MoveLogReader {
+ public:
+  // Delete copy constructor and assignment operator
+  MoveLogReader(const MoveLogReader& reader) = delete;
+  MoveLogReader& operator=(const MoveLogReader& reader) = delete;
+
+  // Constructors
+  MoveLogReader(const std::string& file_name);
+  ~MoveLogReader();
+
+  // Accessors
+  inline bool IsOpen() const { return records_ != nullptr; }
+  inline uint64_t GetNumSlots() const { return num_slots_; }
+  inline uint64_t GetPosition() const { return index_; }
+
+  // Public utils
+  inline void Seek(const uint64_t& index) { index_ = index; }
+  bool Next(MoveLog::Record& record);
+
+ private:
+  void* mapping_;
+  uint64_t mapping_size_;
+  const MoveLog::Record* records_;
+  uint64_t num_slots_;
+  uint64_t index_;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,540 @@
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include "bitboard.h"
+#include "human.h"
+#include "movescript.h"
+
+const unsigned MoveScript::kGamesPerTask;
+const unsigned MoveScript::kMaxCandidates;
+
+/**
+ * Description: Reads a script, replacing the games held.
+ * Parameters: const std::string& file_name: The script file.
+ * Returns: Whether the file could be opened and every line parsed.
+ */
+
+bool MoveScript::Read(const std::string& file_name) {
+  std::ifstream file(file_name);
+  std::string line;
+  games_.clear();
+
+  if (!file) {
+    return false;
+  }
+
+  while (getline(file, line)) {
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+
+    std::istringstream fields(line);
+    std::string kind;
+    std::string hash;
+    fields >> kind;
+
+    if (kind == "game") {
+      Game game = Game();
+
+      if (!(fields >> game.seed)) {
+        return false;
+      }
+
+      games_.push_back(game);
+      continue;
+    }
+
+    if ((kind != "ok" && kind != "reject") || games_.empty() ||
+        !(fields >> hash)) {
+      return false;
+    }
+
+    Attempt attempt;
+    attempt.is_accepted = (kind == "ok");
+    attempt.hash =
+        (attempt.is_accepted ? strtoull(hash.c_str(), NULL, 16) : 0);
+
+    // The lines start after the one space that follows the hash, and may be
+    // empty themselves
+    size_t begin = std::min(kind.size() + hash.size() + 2, line.size());
+
+    while (true) {
+      size_t end = line.find('|', begin);
+      attempt.lines.push_back(line.substr(begin, end - begin));
+
+      if (end == std::string::npos) {
+        break;
+      }
+
+      begin = end + 1;
+    }
+
+    games_.back().attempts.push_back(attempt);
+  }
+
+  return true;
+}
+
+/**
+ * Description: Writes the games held as a script.
+ * Parameters: const std::string& file_name: The script file.
+ * Returns: Whether every line was written.
+ */
+
+bool MoveScript::Write(const std::string& file_name) const {
+  std::ofstream file(file_name);
+
+  if (!file) {
+    return false;
+  }
+
+  for (const Game& game : games_) {
+    file << "game " << game.seed << '\n';
+
+    for (const Attempt& attempt : game.attempts) {
+      if (attempt.is_accepted) {
+        file << "ok " << std::hex << attempt.hash << std::dec;
+      } else {
+        file << "reject -";
+      }
+
+      for (unsigned i = 0; i < attempt.lines.size(); i++) {
+        file << (i ? '|' : ' ') << attempt.lines[i];
+      }
+
+      file << '\n';
+    }
+  }
+
+  return file.good();
+}
+
+/**
+ * Description: Makes up a script by playing random legal moves through the
+ *     prompts. Each move is typed the way a person would, and now and then a
+ *     card the player does not hold is named first, so rejected attempts are
+ *     recorded along with accepted ones. Game i is seeded with
+ *     Random::GetGameSeed(seed, i).
+ * Parameters: const unsigned& num_games: The number of games.
+ * const uint64_t& seed: The seed of the script.
+ * Returns: Nothing.
+ */
+
+void MoveScript::Generate(const unsigned& num_games, const uint64_t& seed) {
+  ThreadPool pool(ThreadPool::GetDefaultNumThreads());
+  games_.assign(num_games, Game());
+
+  for (unsigned first = 0; first < num_games; first += kGamesPerTask) {
+    unsigned last = std::min(first + kGamesPerTask, num_games);
+
+    pool.Submit([this, first, last, seed] {
+      MoveGenerator generator;
+
+      for (unsigned i = first; i < last; i++) {
+        games_[i] = GenerateGame(Random::GetGameSeed(seed, i), generator);
+      }
+    });
+  }
+
+  pool.Wait();
+}
+
+/**
+ * Description: Plays every game of the script across the workers and counts
+ *     the outcomes.
+ * Parameters: const unsigned& num_threads: The number of worker threads.
+ * Returns: Nothing.
+ */
+
+void MoveScript::Run(const unsigned& num_threads) {
+  ThreadPool pool(num_threads);
+  std::vector<Totals> totals(pool.GetNumThreads());
+  auto start = std::chrono::steady_clock::now();
+
+  for (unsigned first = 0; first < games_.size(); first += kGamesPerTask) {
+    unsigned last = std::min<unsigned>(first + kGamesPerTask, games_.size());
+
+    pool.Submit([this, first, last, &totals] {
+      Totals task_totals;
+
+      for (unsigned i = first; i < last; i++) {
+        PlayGame(games_[i], task_totals);
+      }
+
+      totals[ThreadPool::GetWorkerIndex()].Merge(task_totals);
+    });
+  }
+
+  pool.Wait();
+  auto end = std::chrono::steady_clock::now();
+  wall_seconds_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      end - start).count() / 1e9;
+  totals_ = Totals();
+
+  for (unsigned i = 0; i < totals.size(); i++) {
+    totals_.Merge(totals[i]);
+  }
+}
+
+/**
+ * Description: Summarizes the last run as a string.
+ * Parameters: None.
+ * Returns: The summary string.
+ */
+
+std::string MoveScript::ToString() const {
+  std::ostringstream summary;
+  summary << "Games: " << games_.size() << '\n'
+          << "Attempts: " << totals_.num_attempts << '\n'
+          << "Accepted: " << totals_.num_accepted << '\n'
+          << "Rejected: " << totals_.num_rejected << '\n'
+          << "Divergences: " << totals_.num_divergences << '\n'
+          << "Attempts/sec: "
+          << (wall_seconds_ > 0 ? totals_.num_attempts / wall_seconds_ : 0.0)
+          << '\n';
+
+  return summary.str();
+}
+
+/**
+ * Description: Adds another set of counts to these.
+ * Parameters: const Totals& totals: The counts to add.
+ * Returns: Nothing.
+ */
+
+void MoveScript::Totals::Merge(const Totals& totals) {
+  num_attempts += totals.num_attempts;
+  num_accepted += totals.num_accepted;
+  num_rejected += totals.num_rejected;
+  num_divergences += totals.num_divergences;
+}
+
+/**
+ * Description: Deals a round between two humans from a seed, the same way
+ *     GameServer::CreateRound does for computers. The prompts read from the
+ *     queue and every message is dropped.
+ * Parameters: const uint64_t& seed: The seed of the round.
+ * Returns: Nothing.
+ */
+
+MoveScript::ScriptedRound::ScriptedRound(const uint64_t& seed) :
+    input(new InputQueue) {
+  Random rng(seed);
+  unsigned first_player = rng.NextBelow(2);
+
+  for (unsigned i = 0; i < 2; i++) {
+    players.push_back(std::shared_ptr<Player>(new Human));
+    players[i]->SetIsHuman(true);
+    players[i]->SetIsVerbose(false);
+    players[i]->SetNumber(i);
+    players[i]->SetIsTurn(i == first_player);
+  }
+
+  std::shared_ptr<Deck> deck(new Deck(rng));
+  round = std::shared_ptr<Round>(new Round(players, deck, 1));
+  round->SetInput(input);
+  round->SetOutput(std::shared_ptr<OutputSink>(new NullOutput));
+}
+
+/**
+ * Description: Plays one game of the script. Once an attempt diverges the
+ *     rest of the game no longer lines up, so it counts once and the game
+ *     stops there.
+ * Parameters: const Game& game: The game.
+ * Totals& totals: The counts to add to.
+ * Returns: Nothing.
+ */
+
+void MoveScript::PlayGame(const Game& game, Totals& totals) {
+  ScriptedRound scripted(game.seed);
+  bool is_open = NextMove(scripted);
+  Attempt attempt;
+
+  for (const Attempt& expected : game.attempts) {
+    totals.num_attempts++;
+
+    if (!is_open || !TryAttempt(scripted, expected.lines, attempt) ||
+        attempt.lines.size() != expected.lines.size() ||
+        attempt.is_accepted != expected.is_accepted ||
+        attempt.hash != expected.hash) {
+      totals.num_divergences++;
+      return;
+    }
+
+    if (!attempt.is_accepted) {
+      totals.num_rejected++;
+      continue;
+    }
+
+    totals.num_accepted++;
+    is_open = NextMove(scripted);
+  }
+}
+
+/**
+ * Description: Plays one game of random legal moves through the prompts,
+ *     recording every attempt. A move is tried in each of the ways it can be
+ *     typed until the prompts take one; the game ends early if none of a few
+ *     moves is taken.
+ * Parameters: const uint64_t& seed: The seed of the game.
+ * MoveGenerator& generator: The generator to list the legal moves with.
+ * Returns: The recorded game.
+ */
+
+MoveScript::Game MoveScript::GenerateGame(
+    const uint64_t& seed, MoveGenerator& generator) {
+  Game game;
+  game.seed = seed;
+  ScriptedRound scripted(seed);
+  Random rng(Random::GetGameSeed(seed, 1));
+  MoveList moves;
+  std::vector<std::vector<std::string>> dialogues;
+  Attempt attempt;
+  bool is_open = NextMove(scripted);
+
+  while (is_open) {
+    const auto& player = scripted.round->GetCurrentPlayer();
+    const auto& table = scripted.round->GetTable();
+    generator.Generate(player->GetHand(), player->GetNumber(), table, moves);
+    const auto& other_hand =
+        scripted.players[1 - player->GetNumber()]->GetHand();
+
+    // Now and then the player first names one of the other player's cards
+    if (!rng.NextBelow(4) && !other_hand.empty() &&
+        TryAttempt(scripted,
+            {other_hand[rng.NextBelow(other_hand.size())].ToString(), "3"},
+            attempt)) {
+      game.attempts.push_back(attempt);
+    }
+
+    bool is_accepted = false;
+
+    for (unsigned i = 0;
+         i < kMaxCandidates && !is_accepted && !moves.IsEmpty(); i++) {
+      GetDialogues(moves[rng.NextBelow(moves.GetSize())], *table, dialogues);
+
+      for (unsigned j = 0; j < dialogues.size() && !is_accepted; j++) {
+        if (TryAttempt(scripted, dialogues[j], attempt)) {
+          game.attempts.push_back(attempt);
+          is_accepted = attempt.is_accepted;
+        }
+      }
+    }
+
+    if (!is_accepted) {
+      break;
+    }
+
+    is_open = NextMove(scripted);
+  }
+
+  return game;
+}
+
+/**
+ * Description: Types the lines at the current player's prompts.
+ * Parameters: ScriptedRound& scripted: The round.
+ * const std::vector<std::string>& lines: The lines.
+ * Attempt& attempt: An input parameter set to the lines the prompts read and
+ *     what became of the move.
+ * Returns: Whether the move was either made or rejected. It is neither when
+ *     the prompts ran out of lines part way.
+ */
+
+bool MoveScript::TryAttempt(ScriptedRound& scripted,
+    const std::vector<std::string>& lines, Attempt& attempt) {
+  scripted.input->Clear();
+
+  for (const std::string& line : lines) {
+    scripted.input->Push(line);
+  }
+
+  attempt.is_accepted =
+      (scripted.round->Step(Round::kAdvance) == Round::kSwitchingTurn);
+  unsigned num_read = lines.size() - scripted.input->GetNumUnread();
+  scripted.input->Clear();
+
+  if (scripted.round->IsWaitingForInput()) {
+    return false;
+  }
+
+  attempt.lines.assign(lines.begin(), lines.begin() + num_read);
+  attempt.hash = (attempt.is_accepted ? scripted.round->GetHash() : 0);
+
+  return true;
+}
+
+/**
+ * Description: Gets the round ready for the next move, scoring it if there
+ *     are none left.
+ * Parameters: ScriptedRound& scripted: The round.
+ * Returns: Whether there is another move to make.
+ */
+
+bool MoveScript::NextMove(ScriptedRound& scripted) {
+  if (scripted.round->PrepareMove()) {
+    return true;
+  }
+
+  scripted.round->Step(Round::kAdvance);
+
+  return false;
+}
+
+/**
+ * Description: Lists the ways a legal move can be typed at the prompts. A
+ *     capture has a few: the prompt to pick a different card only comes when
+ *     nothing was captured automatically, and builds of the card's value are
+ *     only captured automatically when the hand has one card of that value.
+ * Parameters: const Move& move: The move.
+ * const Table& table: The table the move is made on.
+ * std::vector<std::vector<std::string>>& dialogues: An input parameter set
+ *     to the lines for each way.
+ * Returns: Nothing.
+ */
+
+void MoveScript::GetDialogues(const Move& move, const Table& table,
+    std::vector<std::vector<std::string>>& dialogues) {
+  std::vector<Card> loose_cards;
+  std::vector<Card> captured_cards;
+  std::string card = move.card.ToString();
+  uint64_t same_value = Bitboard::FromValue(move.card.GetValue());
+  dialogues.clear();
+
+  for (const Card& loose_card : table.GetLooseCards()) {
+    if (Bitboard::Contains(move.loose_mask, loose_card)) {
+      loose_cards.push_back(loose_card);
+
+      if (!Bitboard::Contains(same_value, loose_card)) {
+        captured_cards.push_back(loose_card);
+      }
+    }
+  }
+
+  auto get_build = [&table](const unsigned& index) {
+    auto cards = table.GetBuild(index)->GetCards();
+    return Join(std::vector<Card>(cards.begin(), cards.end()));
+  };
+
+  // The menus: action 1 builds, 2 captures and 3 trails; a build is made
+  // with 1, added to with 2 and increased with 3
+  if (move.type == Move::kTrail) {
+    dialogues.push_back({card, "3"});
+  } else if (move.type == Move::kMake) {
+    dialogues.push_back({card, "1", "1", Join(loose_cards)});
+  } else if (move.type == Move::kAdd) {
+    dialogues.push_back({card, "1", "2", Join(loose_cards),
+        get_build(move.build_index)});
+  } else if (move.type == Move::kIncrease) {
+    dialogues.push_back({card, "1", "3", get_build(move.build_index)});
+  }
+
+  if (move.type != Move::kCapture) {
+    return;
+  }
+
+  std::vector<std::vector<Card>> sets;
+  unsigned target =
+      (move.card.IsAce() ? (unsigned) Card::kAceTwo : move.card.GetValue());
+  Partition(captured_cards, target, sets);
+
+  // The capture menu: 1 captures a set, 2 a build and 3 ends the turn
+  for (unsigned variant = 0; variant < 4; variant++) {
+    bool picks_again = variant & 1;
+    bool names_same_value = variant & 2;
+    std::vector<std::string> lines = {card, "2"};
+
+    if (picks_again) {
+      lines.push_back("0");
+    }
+
+    for (const auto& set : sets) {
+      lines.push_back("1");
+      lines.push_back(Join(set));
+    }
+
+    for (unsigned i = 0; i < table.GetNumBuilds(); i++) {
+      unsigned build_sum = table.GetBuild(i)->GetBuildSum();
+
+      if ((move.build_mask >> i) & 1 &&
+          (names_same_value || (build_sum != target &&
+              build_sum != move.card.GetValue()))) {
+        lines.push_back("2");
+        lines.push_back(get_build(i));
+      }
+    }
+
+    lines.push_back("3");
+
+    if (std::find(dialogues.begin(), dialogues.end(), lines) ==
+        dialogues.end()) {
+      dialogues.push_back(lines);
+    }
+  }
+}
+
+/**
+ * Description: Splits cards into sets that each add up to a target.
+ * Parameters: const std::vector<Card>& cards: The cards.
+ * const unsigned& target: The sum of each set.
+ * std::vector<std::vector<Card>>& sets: An input parameter the sets are
+ *     appended to.
+ * Returns: Whether the cards could be split. The sets are left as they were
+ *     if not.
+ */
+
+bool MoveScript::Partition(const std::vector<Card>& cards,
+    const unsigned& target, std::vector<std::vector<Card>>& sets) {
+  if (cards.empty()) {
+    return true;
+  }
+
+  // The first card goes in some set with a subset of the others
+  unsigned num_others = cards.size() - 1;
+
+  for (uint32_t subset = 0; subset < (1U << num_others); subset++) {
+    std::vector<Card> set(1, cards[0]);
+    std::vector<Card> others;
+    unsigned sum = cards[0].GetValue();
+
+    for (unsigned i = 0; i < num_others; i++) {
+      if ((subset >> i) & 1) {
+        set.push_back(cards[i + 1]);
+        sum += cards[i + 1].GetValue();
+      } else {
+        others.push_back(cards[i + 1]);
+      }
+    }
+
+    if (sum != target) {
+      continue;
+    }
+
+    sets.push_back(set);
+
+    if (Partition(others, target, sets)) {
+      return true;
+    }
+
+    sets.pop_back();
+  }
+
+  return false;
+}
+
+/**
+ * Description: Writes cards as one line of a prompt.
+ * Parameters: const std::vector<Card>& cards: The cards.
+ * Returns: The cards separated by spaces.
+ */
+
+std::string MoveScript::Join(const std::vector<Card>& cards) {
+  std::string line;
+
+  for (unsigned i = 0; i < cards.size(); i++) {
+    line += (i ? " " : "") + cards[i].ToString();
+  }
+
+  return line;
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+#ifndef _MOVE_SCRIPT_H_
+#define _MOVE_SCRIPT_H_
+
+#include <string>
+#include <vector>
+#include "inputsource.h"
+#include "movegenerator.h"
+#include "outputsink.h"
+#include "round.h"
+#include "threadpool.h"
+
+// Human moves typed ahead of time, played against the real prompts at full
+// speed. Each game is a round between two humans dealt from a seed, and each
+// attempt is the lines typed for one move along with what the engine made of
+// them: rejected, or accepted with the hash of the position right after.
+// Playing a script counts every attempt whose outcome differs.
+//
+// A script file has one line per game or attempt, cards written as the
+// prompts take them:
+//   game <seed>
+//   ok <hash in hex> <line>|<line>|...
+//   reject - <line>|<line>|...
+class MoveScript {
+ public:
+  // Public structs
+  struct Attempt {
+    std::vector<std::string> lines;
+    bool is_accepted;
+    uint64_t hash;
+  };
+
+  struct Game {
+    uint64_t seed;
+    std::vector<Attempt> attempts;
+  };
+
+  // Delete copy constructor and assignment operator
+  MoveScript(const MoveScript& move_script) = delete;
+  MoveScript& operator=(const MoveScript& move_script) = delete;
+
+  // Constructors
+  MoveScript() : wall_seconds_(0) {}
+
+  // Accessors
+  inline const std::vector<Game>& GetGames() const { return games_; }
+  inline uint64_t GetNumDivergences() const { return totals_.num_divergences; }
+
+  // Public utils
+  bool Read(const std::string& file_name);
+  bool Write(const std::string& file_name) const;
+  void Generate(const unsigned& num_games, const uint64_t& seed);
+  void Run(const unsigned& num_threads);
+  std::string ToString() const;
+
+ private:
+  // Private constants
+  static const unsigned kGamesPerTask = 16;
+  static const unsigned kMaxCandidates = 8;
+
+  // Private structs
+  struct Totals {
+    uint64_t num_attempts = 0;
+    uint64_t num_accepted = 0;
+    uint64_t num_rejected = 0;
+    uint64_t num_divergences = 0;
+
+    void Merge(const Totals& totals);
+  };
+
+  // A round between two humans reading from one queue
+  struct ScriptedRound {
+    std::vector<std::shared_ptr<Player>> players;
+    std::shared_ptr<InputQueue> input;
+    std::shared_ptr<Round> round;
+
+    ScriptedRound(const uint64_t& seed);
+  };
+
+  std::vector<Game> games_;
+  Totals totals_;
+  double wall_seconds_;
+
+  // Private utils
+  static void PlayGame(const Game& game, Totals& totals);
+  static Game GenerateGame(const uint64_t& seed, MoveGenerator& generator);
+  static bool TryAttempt(ScriptedRound& scripted,
+      const std::vector<std::string>& lines, Attempt& attempt);
+  static bool NextMove(ScriptedRound& scripted);
+  static void GetDialogues(const Move& move, const Table& table,
+      std::vector<std::vector<std::string>>& dialogues);
+  static bool Partition(const std::vector<Card>& cards, const unsigned& target,
+      std::vector<std::vector<Card>>& sets);
+  static std::string Join(const std::vector<Card>& cards);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,15 @@
+#include "outputsink.h"
+
+const unsigned FileOutput::kBufferSize;
+
+/**
+ * Description: Opens a file for writing, truncating it, with a large buffer
+ *     so that only flushes reach the file.
+ * Parameters: const std::string& file_name: The file, or a named pipe.
+ * Returns: Nothing.
+ */
+
+FileOutput::FileOutput(const std::string& file_name) {
+  stream_.rdbuf()->pubsetbuf(buffer_, kBufferSize);
+  stream_.open(file_name);
+}
\ No newline at end of file
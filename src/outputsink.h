@@ -0,0 +1,85 @@
+#ifndef _OUTPUT_SINK_H_
+#define _OUTPUT_SINK_H_
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+// Where the game's messages go. Writes are buffered and only pushed out on
+// Flush, which a round calls at turn boundaries and before it waits for input.
+class OutputSink {
+ public:
+  virtual ~OutputSink() = default;
+
+  // Accessors
+  // Whether everything written is thrown away, so callers can skip building
+  // the text in the first place
+  virtual bool IsNull() const { return false; }
+  virtual std::ostream& GetStream() = 0;
+
+  // Public utils
+  virtual void Flush() {}
+};
+
+// Writes to stdout.
+class ConsoleOutput : public OutputSink {
+ public:
+  // Accessors
+  inline std::ostream& GetStream() { return std::cout; }
+
+  // Public utils
+  inline void Flush() { std::cout.flush(); }
+};
+
+// Keeps everything written in memory.
+class MemoryOutput : public OutputSink {
+ public:
+  // Accessors
+  inline std::ostream& GetStream() { return stream_; }
+  inline std::string GetText() const { return stream_.str(); }
+
+  // Public utils
+  inline void Clear() { stream_.str(std::string()); }
+
+ private:
+  std::ostringstream stream_;
+};
+
+// Drops everything. The stream has no buffer, so writes to it fail before any
+// formatting is done.
+class NullOutput : public OutputSink {
+ public:
+  // Constructors
+  NullOutput() : stream_(nullptr) {}
+
+  // Accessors
+  inline bool IsNull() const { return true; }
+  inline std::ostream& GetStream() { return stream_; }
+
+ private:
+  std::ostream stream_;
+};
+
+// Writes to a file, or to a named pipe.
+class FileOutput : public OutputSink {
+ public:
+  // Constructors
+  FileOutput(const std::string& file_name);
+
+  // Accessors
+  inline bool IsOpen() const { return stream_.is_open(); }
+  inline std::ostream& GetStream() { return stream_; }
+
+  // Public utils
+  inline void Flush() { stream_.flush(); }
+
+ private:
+  // Private constants
+  static const unsigned kBufferSize = 64 * 1024;
+
+  char buffer_[kBufferSize];
+  std::ofstream stream_;
+};
+
+#endif
\ No newline at end of file
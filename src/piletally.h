@@ -0,0 +1,43 @@
+#ifndef _PILE_TALLY_H_
+#define _PILE_TALLY_H_
+
+#include "bitboard.h"
+
+// What a pile scores on at the end of a round, counted as cards enter and
+// leave it so a round can be scored without looking at its cards.
+struct PileTally {
+  uint8_t num_cards;
+  uint8_t num_spades;
+  uint8_t num_points;
+
+  PileTally() : num_cards(0), num_spades(0), num_points(0) {}
+
+  inline void Add(const Card& card) {
+    num_cards++;
+    num_spades += (card.GetSuit() == Card::kSpades);
+    num_points += card.GetPoints();
+  }
+
+  inline void Remove(const Card& card) {
+    num_cards--;
+    num_spades -= (card.GetSuit() == Card::kSpades);
+    num_points -= card.GetPoints();
+  }
+
+  inline void Merge(const PileTally& tally) {
+    num_cards += tally.num_cards;
+    num_spades += tally.num_spades;
+    num_points += tally.num_points;
+  }
+
+  static inline PileTally FromMask(const uint64_t& mask) {
+    PileTally tally;
+    tally.num_cards = Bitboard::Count(mask);
+    tally.num_spades = Bitboard::CountSpades(mask);
+    tally.num_points = Bitboard::CountPoints(mask);
+
+    return tally;
+  }
+};
+
+#endif
\ No newline at end of file
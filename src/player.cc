@@ -5,21 +5,24 @@
  * Due Date: 10/2/18           *
  *******************************/
 
-#include <unordered_set>
 #include <algorithm>
 #include "player.h"
+#include "subsetsum.h"
+#include "movegenerator.h"
 #include "inputhandler.h"
 #include "gui.h"
 
 /**
  * Description: Removes the card at index from the hand.
  * Parameters: const unsigned& index: The index of the card to remove.
- * Returns: An pointer to the card that was removed.
+ * Returns: The card that was removed.
  */
 
-std::shared_ptr<Card> Player::RemoveFromHand(const unsigned& index) {
-  std::shared_ptr<Card> return_card = hand_[index];
+Card Player::RemoveFromHand(const unsigned& index) {
+  Card return_card = hand_[index];
   hand_.erase(hand_.begin() + index);
+  hand_mask_ &= ~Bitboard::FromCard(return_card);
+  hash_ ^= kZobristKeys.hand[number_ & 1][return_card.GetId()];
 
   return return_card;
 }
@@ -38,13 +41,13 @@ std::string Player::ToString() const {
   player += "\n\tHand: ";
 
   for (auto card : hand_) {
-    player += card->ToString() + ' ';
+    player += card.ToString() + ' ';
   }
 
   player += "\n\tPile: ";
 
   for (auto card : pile_) {
-    player += card->ToString() + ' ';
+    player += card.ToString() + ' ';
   }
 
   player += '\n';
@@ -61,15 +64,15 @@ std::string Player::ToString() const {
 
 void Player::TrailAction(
     const unsigned& card_index, std::shared_ptr<Table>& table) {
-  std::shared_ptr<Card> card = RemoveFromHand(card_index);
+  Card card = RemoveFromHand(card_index);
   table->AddLooseCard(card);
 }
 
 /**
  * Description: Makes a build for the given parameters.
  * Parameters: const unsigned& card_index: The index of the played card.
- * const std::vector<std::shared_ptr<Card>>& cards: The cards to build with.
- * const std::vector<unsigned>& card_indices: The indices of the chosen cards.
+ * const std::vector<Card>& cards: The cards to build with.
+ * const uint64_t& card_positions: The positions of the chosen loose cards.
  * const unsigned& build_sum: The build sum.
  * std::shared_ptr<Table>& table: The current table state.
  * Returns: Nothing.
@@ -77,16 +80,15 @@ void Player::TrailAction(
 
 void Player::MakeBuildAction(
     const unsigned& card_index,
-    const std::vector<std::shared_ptr<Card>>& cards,
-    const std::vector<unsigned>& card_indices, const unsigned& build_sum,
-    std::shared_ptr<Table>& table) {
+    const std::vector<Card>& cards, const uint64_t& card_positions,
+    const unsigned& build_sum, std::shared_ptr<Table>& table) {
   std::shared_ptr<Build> build(new Build);
   RemoveFromHand(card_index);
   build->AddToBuild(cards);
   build->SetBuildSum(build_sum);
-  table->RemoveLooseCards(card_indices);
-  table->AddBuild(build);
   build->SetOwnerIndex(number_);
+  table->RemoveLooseCards(card_positions);
+  table->AddBuild(build);
 }
 
 /**
@@ -103,37 +105,36 @@ void Player::IncreaseBuildAction(
       const unsigned& build_sum, std::shared_ptr<Table>& table) {
   build->AddToSingleBuild(hand_[card_index]);
   RemoveFromHand(card_index);
-  build->SetBuildSum(build_sum);
-  build->SetOwnerIndex(number_);
+  table->UpdateBuild(build, build_sum, number_);
 }
 
 /**
  * Description: Adds to a build for the given parameters.
  * Parameters: const unsigned& card_index: The index of the played card.
  * std::shared_ptr<Build>& build: The build to add to.
- * const std::vector<std::shared_ptr<Card>>& cards: The cards to build with.
- * const std::vector<unsigned>& card_indices: The indices of the chosen cards.
+ * const std::vector<Card>& cards: The cards to build with.
+ * const uint64_t& card_positions: The positions of the chosen loose cards.
  * std::shared_ptr<Table>& table: The current table state.
  * Returns: Nothing.
  */
 
 void Player::AddToBuildAction(
     const unsigned& card_index, std::shared_ptr<Build>& build,
-    const std::vector<std::shared_ptr<Card>>& cards,
-    const std::vector<unsigned>& card_indices, std::shared_ptr<Table>& table) {
+    const std::vector<Card>& cards, const uint64_t& card_positions,
+    std::shared_ptr<Table>& table) {
   RemoveFromHand(card_index);
   build->AddToBuild(cards);
-  table->RemoveLooseCards(card_indices);
-  build->SetOwnerIndex(number_);
+  table->RemoveLooseCards(card_positions);
+  table->UpdateBuild(build, build->GetBuildSum(), number_);
 }
 
 void Player::CaptureSetAction(
-    const std::vector<unsigned>& card_indices, std::shared_ptr<Table>& table) {
-  for (unsigned i = 0; i < card_indices.size(); i++) {
-    pile_.push_back(table->GetLooseCard(card_indices[i]));
+    const uint64_t& card_positions, std::shared_ptr<Table>& table) {
+  for (uint64_t rest = card_positions; rest; rest &= rest - 1) {
+    AddToPile(table->GetLooseCard(__builtin_ctzll(rest)));
   }
 
-  table->RemoveLooseCards(card_indices);
+  table->RemoveLooseCards(card_positions);
 }
 
 /**
@@ -145,10 +146,10 @@ void Player::CaptureSetAction(
 
 void Player::CaptureBuildAction(
     const unsigned& build_index, std::shared_ptr<Table>& table) {
-  auto deconstructed_build = table->DeconstructBuild(build_index);
+  const auto& build = table->GetBuild(build_index);
 
-  for (unsigned i = 0; i < deconstructed_build.size(); i++) {
-    pile_.push_back(deconstructed_build[i]);
+  for (auto card : build->GetCards()) {
+    AddToPile(card);
   }
 
   table->RemoveBuild(build_index);
@@ -163,25 +164,19 @@ void Player::CaptureBuildAction(
 
 bool Player::CaptureAllCardsWithSameValue(
     const unsigned& card_index, std::shared_ptr<Table>& table) {
-  bool matches = false;
-  unsigned value = hand_[card_index]->GetValue();
-  auto card_in_hand = hand_[card_index];
-  std::vector<unsigned> card_indices;
+  uint64_t matches =
+      table->GetLooseMask() & Bitboard::FromValue(hand_[card_index].GetValue());
+  const auto& loose_cards = table->GetLooseCards();
 
-  for (unsigned i = 0; i < table->GetLooseCards().size(); i++) {
-    auto card_on_table = table->GetLooseCards()[i];
-
-    if ((card_on_table->IsAce() && card_in_hand->IsAce()) ||
-        (card_on_table->GetValue() == value)) {
-      pile_.push_back(card_on_table);
-      card_indices.push_back(i);
-      matches = true;
+  for (unsigned i = 0; i < loose_cards.size(); i++) {
+    if (Bitboard::Contains(matches, loose_cards[i])) {
+      AddToPile(loose_cards[i]);
     }
   }
 
-  table->RemoveLooseCards(card_indices);
+  table->RemoveLooseCardsInMask(matches);
 
-  return matches;
+  return matches != Bitboard::kEmpty;
 }
 
 /**
@@ -194,35 +189,54 @@ bool Player::CaptureAllCardsWithSameValue(
 bool Player::CaptureAllBuildsWithSameValue(
     const unsigned& card_index, std::shared_ptr<Table>& table) {
   bool matches = false;
-  unsigned value = hand_[card_index]->GetValue();
+  unsigned value = hand_[card_index].GetValue();
   auto card_in_hand = hand_[card_index];
-  std::vector<unsigned> build_indices;
-
-  for (unsigned i = 0; i < table->GetCurrentBuilds().size(); i++) {
-    auto build = table->GetCurrentBuilds()[i];
+  uint32_t build_mask = 0;
 
-    if (number_ && build->GetOwnerIndex() != number_) {
-      continue;
-    }
+  for (unsigned i = 0; i < table->GetNumBuilds(); i++) {
+    const auto& build = table->GetBuild(i);
 
     if ((build->GetBuildSum() == value) ||
-        (card_in_hand->IsAce() && build->GetBuildSum() == Card::kAceTwo)) {
-      auto deconstructed_build = table->DeconstructBuild(i);
-
-      for (unsigned j = 0; j < deconstructed_build.size(); j++) {
-        pile_.push_back(deconstructed_build[j]);
+        (card_in_hand.IsAce() && build->GetBuildSum() == Card::kAceTwo)) {
+      for (auto card : build->GetCards()) {
+        AddToPile(card);
       }
 
-      build_indices.push_back(i);
+      build_mask |= 1U << i;
       matches = true;
     }
   }
 
-  table->RemoveMultipleBuilds(build_indices);
+  table->RemoveBuildsInMask(build_mask);
 
   return matches;
 }
 
+/**
+ * Description: Takes loose cards off the table and saves them to the journal.
+ * Parameters: const uint64_t& mask: The loose cards to take.
+ * std::shared_ptr<Table>& table: The current table state.
+ * MoveJournal& journal: The journal to save the cards to.
+ * Returns: The positions the cards were taken from, bit i for index i.
+ */
+
+uint64_t Player::TakeLooseCards(
+    const uint64_t& mask, std::shared_ptr<Table>& table,
+    MoveJournal& journal) {
+  uint64_t positions = 0;
+
+  for (unsigned i = 0; i < table->GetNumLooseCards(); i++) {
+    if (Bitboard::Contains(mask, table->GetLooseCard(i))) {
+      journal.SaveLooseCard(table->GetLooseCard(i));
+      positions |= 1ULL << i;
+    }
+  }
+
+  table->RemoveLooseCardsInMask(mask);
+
+  return positions;
+}
+
 /**
  * Description: Checks if player has a card with the build sum.
  * Parameters: const unsigned& card_index: The index of the played card.
@@ -232,16 +246,7 @@ bool Player::CaptureAllBuildsWithSameValue(
 
 bool Player::HasCardWithBuildSum(
     const unsigned& card_index, const unsigned& build_sum) const {
-  for (unsigned i = 0; i < hand_.size(); i++) {
-    auto card = hand_[i];
-
-    if ((i != card_index && card->GetValue() == build_sum) ||
-        (card->IsAce() && build_sum == Card::kAceTwo)) {
-      return true;
-    }
-  }
-
-  return false;
+  return GetBuildableSums(card_index) & SubsetSum::SumToMask(build_sum);
 }
 
 /**
@@ -251,14 +256,14 @@ bool Player::HasCardWithBuildSum(
  */
 
 bool Player::HasMultipleOfSameCard(const unsigned& card_index) const {
-  unsigned value = hand_[card_index]->GetValue();
+  unsigned value = hand_[card_index].GetValue();
 
   for (unsigned i = 0; i < hand_.size(); i++) {
     if (i == card_index) {
       continue;
     }
 
-    if (value == hand_[i]->GetValue()) {
+    if (value == hand_[i].GetValue()) {
       return true;
     }
   }
@@ -270,217 +275,175 @@ bool Player::HasMultipleOfSameCard(const unsigned& card_index) const {
  * Description: Gets all valid sets that sum up to the given value.
  * Parameters: const unsigned& value: The value.
  * const std::shared_ptr<Table>& table: The current table state.
- * Returns: All valid sets.
+ * Returns: All valid sets, as masks of loose card positions on the thread's
+ *     arena.
  */
 
-std::vector<std::vector<unsigned>> Player::GetAllValidSets(
+ScratchVector<uint64_t> Player::GetAllValidSets(
     const unsigned& value, const std::shared_ptr<Table>& table) const {
-  std::vector<std::vector<unsigned>> return_sets;
-  auto loose_cards = table->GetLooseCards();
-
-  for (unsigned i = 0; i < (1 << loose_cards.size()); i++) {
-    std::vector<unsigned> subset;
-    unsigned sum = 0;
+  ScratchVector<uint64_t> subsets(&Arena::GetThreadArena());
+  unsigned target =
+      (value == Card::kAceOne ? (unsigned) Card::kAceTwo : value);
+  SubsetSum::FindSubsets(table->GetLooseCards(), 0,
+      SubsetSum::SumToMask(target), 2, subsets);
 
-    for (unsigned j = 0; j < loose_cards.size(); j++) {
-      if (i & (1 << j)) {
-        subset.push_back(j);
-        sum += loose_cards[j]->GetValue();
-      }
-    }
-
-    if ((subset.size() > 1 && (sum == value)) ||
-        (value == Card::kAceOne && sum == Card::kAceTwo)) {
-      return_sets.push_back(subset);
-    }
-  }
-
-  return return_sets;
+  return subsets;
 }
 
 /**
- * Description: Gets all valid sets of sets that sum up to a given value
- *     (No duplicates).
- * Parameters: const std::vector<std::vector<unsigned>>& sets: The sets to check
- *     against.
- * Returns: All valid sets.
+ * Description: Gets the valid set of sets that scores the most, without
+ *     listing the sets of sets.
+ * Parameters: const unsigned& value: The value.
+ * const std::shared_ptr<Table>& table: The current table state.
+ * const uint64_t& taken: The loose card positions the capture takes anyway,
+ *     which no set may use.
+ * unsigned& score: An input parameter set to the score of its cards.
+ * Returns: The set of sets, as a mask of loose card positions.
  */
 
-std::vector<std::vector<unsigned>> Player::GetAllValidSetsOfSets(
-    const std::vector<std::vector<unsigned>>& sets) const {
-  std::vector<std::vector<unsigned>> return_sets;
-
-  for (unsigned i = 0; i < (1 << sets.size()); i++) {
-    std::vector<unsigned> subset;
-    bool add = true;
-    std::unordered_set<unsigned> seen;
-
-    for (unsigned j = 0; j < sets.size(); j++) {
-      if (i & (1 << j)) {
-        for (unsigned k = 0; k < sets[j].size(); k++) {
-          if (seen.find(sets[j][k]) != seen.end()) {
-            add = false;
-          }
-
-          subset.push_back(sets[j][k]);
-          seen.insert(sets[j][k]);
-        }
-      }
-    }
+uint64_t Player::GetBestValidSetOfSets(const unsigned& value,
+    const std::shared_ptr<Table>& table, const uint64_t& taken,
+    unsigned& score) const {
+  const auto& loose_cards = table->GetLooseCards();
+  unsigned target =
+      (value == Card::kAceOne ? (unsigned) Card::kAceTwo : value);
+  unsigned weights[Card::kNumCards];
 
-    if (add) {
-      return_sets.push_back(subset);
-    }
+  for (unsigned i = 0; i < loose_cards.size(); i++) {
+    weights[i] = GetCardScore(loose_cards[i]);
   }
 
-  return return_sets;
+  return SubsetSum::FindBestPacking(loose_cards, taken,
+      SubsetSum::SumToMask(target), weights, score);
 }
 
 /**
- * Description: Finds the best capture move.
+ * Description: Finds the best capture move. Each hand card is searched on its
+ *     own, in parallel with a search pool, and the results are compared in
+ *     hand order, so the choice is the same however many threads search.
  * Parameters: const std::shared_ptr<Table>& table: The current table state.
  * Returns: The best capture.
  */
 
-std::shared_ptr<CaptureNode> Player::FindBestCapture(
+CaptureNode* Player::FindBestCapture(
     const std::shared_ptr<Table>& table) const {
+  Arena& arena = Arena::GetThreadArena();
+  ScratchVector<CaptureNode> captures(hand_.size(), CaptureNode(), &arena);
+
+  RunSearchTasks(table, hand_.size(),
+      [this, &table, &captures](const unsigned& i) {
+    FindBestCaptureWith(i, table, captures[i]);
+  });
+
   unsigned max_score = 0;
   unsigned max_index = 0;
-  std::vector<unsigned> max_set;
-  auto loose_cards = table->GetLooseCards();
-  auto builds = table->GetCurrentBuilds();
-  std::vector<unsigned> max_loose;
-  std::vector<unsigned> max_builds;
 
-  for (unsigned i = 0; i < hand_.size(); i++) {
-    auto valid_sets = 
-        GetAllValidSetsOfSets(GetAllValidSets(hand_[i]->GetValue(), table));
-    std::vector<unsigned> loose_indices;
-    std::vector<unsigned> build_indices;
-    unsigned score = 0;
-
-    for (unsigned j = 0; j < loose_cards.size(); j++) {
-      if ((hand_[i]->IsAce() && loose_cards[j]->IsAce()) ||
-          (hand_[i]->GetValue() == loose_cards[j]->GetValue())) {
-        loose_indices.push_back(j);
-        score += GetCardScore(loose_cards[j]);
-      }
+  for (unsigned i = 0; i < captures.size(); i++) {
+    if (captures[i].GetScore() > max_score) {
+      max_score = captures[i].GetScore();
+      max_index = i;
     }
+  }
+
+  CaptureNode* best_capture = arena.New<CaptureNode>(captures[max_index]);
+  best_capture->AddToScore(GetCardScore(hand_[max_index]));
 
-    for (unsigned j = 0; j < builds.size(); j++) {
-      if ((hand_[i]->IsAce() && builds[j]->GetBuildSum() == Card::kAceTwo) ||
-          (hand_[i]->GetValue() == builds[j]->GetBuildSum())) {
-        build_indices.push_back(j);
-        auto deconstructed_build = table->DeconstructBuild(j);
+  return best_capture;
+}
 
-        for (unsigned k = 0; k < deconstructed_build.size(); k++) {
-          score += GetCardScore(deconstructed_build[k]);
-        }
-      }
-    }
+/**
+ * Description: Finds the best capture with one hand card. The score leaves
+ *     out the played card, and is 0 when nothing can be captured.
+ * Parameters: const unsigned& index: The index of the played card.
+ * const std::shared_ptr<Table>& table: The current table state.
+ * CaptureNode& best_capture: An input parameter set to the best capture.
+ * Returns: Nothing.
+ */
 
-    for (unsigned j = 0; j < valid_sets.size(); j++) {
-      unsigned set_score = 0;
-      
-      for (unsigned k = 0; k < valid_sets[j].size(); k++) {
-        set_score += GetCardScore(loose_cards[valid_sets[j][k]]);
-      }
+void Player::FindBestCaptureWith(const unsigned& index,
+    const std::shared_ptr<Table>& table, CaptureNode& best_capture) const {
+  const Card& card = hand_[index];
+  const auto& loose_cards = table->GetLooseCards();
+  const auto& builds = table->GetCurrentBuilds();
+  uint64_t loose_mask = 0;
+  uint32_t build_mask = 0;
+  unsigned score = 0;
+  best_capture = CaptureNode();
+  best_capture.SetPlayedCardIndex(index);
 
-      score += set_score;
-
-      if (score > max_score) {
-        max_score = score;
-        max_index = i;
-        max_loose = loose_indices;
-        max_builds = build_indices;
-        max_set = valid_sets[j];
-        score -= set_score;
-      } else {
-        score -= set_score;
-      }
+  for (unsigned j = 0; j < loose_cards.size(); j++) {
+    if ((card.IsAce() && loose_cards[j].IsAce()) ||
+        (card.GetValue() == loose_cards[j].GetValue())) {
+      loose_mask |= 1ULL << j;
+      score += GetCardScore(loose_cards[j]);
     }
   }
 
-  std::shared_ptr<CaptureNode> best_capture(new CaptureNode);
-  best_capture->SetPlayedCardIndex(max_index);
-  best_capture->AddToScore(max_score);
-  best_capture->AddToScore(GetCardScore(hand_[max_index]));
-  best_capture->SetBuildIndices(max_builds);
-  best_capture->SetLooseCardIndices(max_loose);
+  for (unsigned j = 0; j < builds.size(); j++) {
+    if ((card.IsAce() && builds[j]->GetBuildSum() == Card::kAceTwo) ||
+        (card.GetValue() == builds[j]->GetBuildSum())) {
+      build_mask |= 1U << j;
+      score += builds[j]->GetScore();
+    }
+  }
 
-  if (!max_set.empty()) {
-    best_capture->AddSetIndices(max_set);
+  // An ace's sets of fourteen could use a loose ace it takes anyway
+  unsigned set_score = 0;
+  uint64_t set_mask =
+      GetBestValidSetOfSets(card.GetValue(), table, loose_mask, set_score);
+  score += set_score;
+
+  if (score) {
+    best_capture.SetLooseCardMask(loose_mask);
+    best_capture.SetBuildMask(build_mask);
+    best_capture.SetSetMask(set_mask);
   }
 
-  return best_capture;
+  best_capture.AddToScore(score);
 }
 
 /**
- * Description: Finds the best build move.
+ * Description: Finds the best build move. The make, add and increase builds
+ *     of each hand card are searched on their own, in parallel with a search
+ *     pool, and the results are compared in hand order, so the choice is the
+ *     same however many threads search.
  * Parameters: const std::shared_ptr<Table>& table: The current table state.
  * Returns: The best build.
  */
 
-std::shared_ptr<BuildNode> Player::FindBestBuild(
-    const std::shared_ptr<Table>& table) const {
-  unsigned best_single_score = 0;
-  std::shared_ptr<BuildNode> best_single(new BuildNode);
-  unsigned best_multi_score = 0;
-  std::shared_ptr<BuildNode> best_multi(new BuildNode);
-  unsigned best_increase_score = 0;
-  std::shared_ptr<BuildNode> best_increase(new BuildNode);
+BuildNode* Player::FindBestBuild(const std::shared_ptr<Table>& table) const {
+  Arena& arena = Arena::GetThreadArena();
+  ScratchVector<BuildNode> nodes(3 * hand_.size(), BuildNode(), &arena);
 
-  for (unsigned i = 0; i < hand_.size(); i++) {
-    auto single_node = FindBestSingleBuild(i, table);
-    auto multi_node = FindBestMultiBuild(i, table);
-    auto increase_node = FindBestIncreaseBuild(i, table);
+  RunSearchTasks(table, nodes.size(),
+      [this, &table, &nodes](const unsigned& i) {
+    unsigned index = i / 3;
 
-    if (single_node->GetScore() > best_single_score) {
-      best_single_score = single_node->GetScore();
-      best_single = single_node;
+    if (i % 3 == 0) {
+      nodes[i] = *FindBestSingleBuild(index, table);
+    } else if (i % 3 == 1) {
+      nodes[i] = *FindBestMultiBuild(index, table);
+    } else {
+      nodes[i] = *FindBestIncreaseBuild(index, table);
     }
+  });
 
-    if (multi_node->GetScore() > best_multi_score) {
-      best_multi_score = multi_node->GetScore();
-      best_multi = multi_node;
-    }
+  // The best make, add and increase build, in that order
+  BuildNode empty[3];
+  const BuildNode* builds[] = {&empty[0], &empty[1], &empty[2]};
 
-    if (increase_node->GetScore() > best_increase_score) {
-      best_increase_score = increase_node->GetScore();
-      best_increase = increase_node;
+  for (unsigned i = 0; i < nodes.size(); i++) {
+    if (nodes[i].GetScore() > builds[i % 3]->GetScore()) {
+      builds[i % 3] = &nodes[i];
     }
   }
 
-  std::vector<std::shared_ptr<BuildNode>> builds{
-      best_single, best_multi, best_increase};
-
-  std::sort(builds.begin(), builds.end(), [](
-      const std::shared_ptr<BuildNode>& one,
-      const std::shared_ptr<BuildNode>& two) {
+  std::sort(builds, builds + 3, [](
+      const BuildNode* one, const BuildNode* two) {
     return one->GetScore() > two->GetScore();
   });
 
-  return builds[0];
-}
-
-/**
- * Description: Checks if the value is found on the table.
- * Parameters: const unsgined& value: The value.
- * const std::shared_ptr<Table>& table: The current table state.
- * Returns: Whether or not the value was found.
- */
-
-bool Player::MatchesCardOnTable(
-    const unsigned& value, const std::shared_ptr<Table>& table) const {
-  auto loose_cards = table->GetLooseCards();
-
-  for (unsigned i = 0; i < loose_cards.size(); i++) {
-    if (value == loose_cards[i]->GetValue()) {
-      return true;
-    }
-  }
-
-  return false;
+  return arena.New<BuildNode>(*builds[0]);
 }
 
 /**
@@ -492,15 +455,7 @@ bool Player::MatchesCardOnTable(
 
 bool Player::MatchesBuildOnTable(
     const unsigned& value, const std::shared_ptr<Table>& table) const {
-  auto builds = table->GetCurrentBuilds();
-
-  for (unsigned i = 0; i < builds.size(); i++) {
-    if (value == builds[i]->GetBuildSum()) {
-      return true;
-    }
-  }
-
-  return false;
+  return table->ValueMatchesAnyBuild(value);
 }
 
 /**
@@ -510,54 +465,29 @@ bool Player::MatchesBuildOnTable(
  * Returns: The best single build.
  */
 
-std::shared_ptr<BuildNode> Player::FindBestSingleBuild(
+BuildNode* Player::FindBestSingleBuild(
     const unsigned& index, const std::shared_ptr<Table>& table) const {
-  auto loose_cards = table->GetLooseCards();
-  std::vector<std::vector<unsigned>> valid_sets;
-  std::unordered_set<unsigned> values;
-  unsigned value = hand_[index]->GetValue();
-
-  for (unsigned i = 0; i < hand_.size(); i++) {
-    if (index == i) {
-      continue;
-    }
-
-    if (hand_[i]->GetValue() == Card::kAceOne) {
-      values.insert(Card::kAceTwo);
-    }
-
-    values.insert(hand_[i]->GetValue());
-  }
-
-  if (!MatchesCardOnTable(hand_[index]->GetValue(), table)) {
-    for (unsigned i = 0; i < (1 << loose_cards.size()); i++) {
-      std::vector<unsigned> subset;
-      unsigned sum = value;
-
-      for (unsigned j = 0; j < loose_cards.size(); j++) {
-        if (i & (1 << j)) {
-          subset.push_back(j);
-          sum += loose_cards[j]->GetValue();
-        }
-      }
+  Arena& arena = Arena::GetThreadArena();
+  const auto& loose_cards = table->GetLooseCards();
+  ScratchVector<uint64_t> valid_sets(&arena);
+  unsigned value = hand_[index].GetValue();
 
-      if (values.find(sum) != values.end()) {
-        valid_sets.push_back(subset);
-      }
-    }
+  if (!MoveGenerator::MustCapture(hand_[index], number_, table)) {
+    SubsetSum::FindSubsets(
+        loose_cards, value, GetBuildableSums(index), 0, valid_sets);
   }
 
   unsigned max_score = GetCardScore(hand_[index]);
   bool score_updated = false;
-  std::vector<unsigned> max_set;
-  std::shared_ptr<BuildNode> single_node(new BuildNode);
+  uint64_t max_set = 0;
+  BuildNode* single_node = arena.New<BuildNode>();
   single_node->SetPlayedCardIndex(index);
 
   for (unsigned i = 0; i < valid_sets.size(); i++) {
     unsigned score = GetCardScore(hand_[index]);
 
-    for (unsigned j = 0; j < valid_sets[i].size(); j++) {
-      score += GetCardScore(loose_cards[valid_sets[i][j]]);
+    for (uint64_t rest = valid_sets[i]; rest; rest &= rest - 1) {
+      score += GetCardScore(loose_cards[__builtin_ctzll(rest)]);
     }
 
     if (score > max_score) {
@@ -571,7 +501,7 @@ std::shared_ptr<BuildNode> Player::FindBestSingleBuild(
     single_node->AddToScore(max_score);
   }
 
-  single_node->SetLooseCardIndices(max_set);
+  single_node->SetLooseCardMask(max_set);
   single_node->SetType(BuildNode::kMake);
 
   return single_node;
@@ -584,64 +514,46 @@ std::shared_ptr<BuildNode> Player::FindBestSingleBuild(
  * Returns: The best multi build.
  */
 
-std::shared_ptr<BuildNode> Player::FindBestMultiBuild(
+BuildNode* Player::FindBestMultiBuild(
     const unsigned& index, const std::shared_ptr<Table>& table) const {
-  auto loose_cards = table->GetLooseCards();
-  auto builds = table->GetCurrentBuilds();
-  std::unordered_set<unsigned> values;
-  unsigned value = hand_[index]->GetValue();
-  BuildAndLooseIndices bali;
-
-  for (unsigned i = 0; i < hand_.size(); i++) {
-    if (index == i) {
-      continue;
-    }
-
-    if (hand_[i]->GetValue() == Card::kAceOne) {
-      values.insert(Card::kAceTwo);
-    }
-
-    values.insert(hand_[i]->GetValue());
-  }
-
-  if (!MatchesCardOnTable(hand_[index]->GetValue(), table)) {
-    for (unsigned i = 0; i < (1 << loose_cards.size()); i++) {
-      std::vector<unsigned> subset;
+  Arena& arena = Arena::GetThreadArena();
+  const auto& loose_cards = table->GetLooseCards();
+  const auto& builds = table->GetCurrentBuilds();
+  unsigned value = hand_[index].GetValue();
+  BuildAndLooseIndices bali(&arena);
+
+  if (!MoveGenerator::MustCapture(hand_[index], number_, table)) {
+    ScratchVector<uint64_t> subsets(&arena);
+    SubsetSum::FindSubsets(
+        loose_cards, value, GetBuildableSums(index), 0, subsets);
+
+    for (unsigned i = 0; i < subsets.size(); i++) {
       unsigned sum = value;
 
-      for (unsigned j = 0; j < loose_cards.size(); j++) {
-        if (i & (1 << j)) {
-          subset.push_back(j);
-          sum += loose_cards[j]->GetValue();
-        }
+      for (uint64_t rest = subsets[i]; rest; rest &= rest - 1) {
+        sum += loose_cards[__builtin_ctzll(rest)].GetValue();
       }
 
-      if (values.find(sum) != values.end()) {
-        for (unsigned j = 0; j < builds.size(); j++) {
-          if (sum == builds[j]->GetBuildSum()) {
-            bali.push_back(std::make_pair(j, subset));
-          }
+      for (unsigned j = 0; j < builds.size(); j++) {
+        if (sum == builds[j]->GetBuildSum()) {
+          bali.push_back(std::make_pair(j, subsets[i]));
         }
       }
     }
   }
 
-  std::pair<unsigned, std::vector<unsigned>> max_build_and_loose;
+  std::pair<unsigned, uint64_t> max_build_and_loose(0, 0);
   unsigned max_score = GetCardScore(hand_[index]);
   bool score_updated = false;
-  std::shared_ptr<BuildNode> multi_node(new BuildNode);
+  BuildNode* multi_node = arena.New<BuildNode>();
   multi_node->SetPlayedCardIndex(index);
 
   for (auto p : bali) {
-    unsigned score = GetCardScore(hand_[index]);
-    auto deconstructed_build = table->DeconstructBuild(p.first);
+    unsigned score =
+        GetCardScore(hand_[index]) + builds[p.first]->GetScore();
 
-    for (unsigned i = 0; i < deconstructed_build.size(); i++) {
-      score += GetCardScore(deconstructed_build[i]);
-    }
-
-    for (unsigned i = 0; i < p.second.size(); i++) {
-      score += GetCardScore(loose_cards[p.second[i]]);
+    for (uint64_t rest = p.second; rest; rest &= rest - 1) {
+      score += GetCardScore(loose_cards[__builtin_ctzll(rest)]);
     }
 
     if (score > max_score) {
@@ -651,7 +563,7 @@ std::shared_ptr<BuildNode> Player::FindBestMultiBuild(
     }
   }
 
-  multi_node->SetLooseCardIndices(max_build_and_loose.second);
+  multi_node->SetLooseCardMask(max_build_and_loose.second);
   multi_node->SetBuildIndex(max_build_and_loose.first);
   multi_node->SetType(BuildNode::kAdd);
 
@@ -669,56 +581,41 @@ std::shared_ptr<BuildNode> Player::FindBestMultiBuild(
  * Returns: The best increase build.
  */
 
-std::shared_ptr<BuildNode> Player::FindBestIncreaseBuild(
+BuildNode* Player::FindBestIncreaseBuild(
     const unsigned& index, const std::shared_ptr<Table>& table) const {
-  auto builds = table->GetCurrentBuilds();
-  std::unordered_set<unsigned> values;
-  std::vector<unsigned> build_indices;
-
-  for (unsigned i = 0; i < hand_.size(); i++) {
-    if (index == i) {
-      continue;
-    }
+  const auto& builds = table->GetCurrentBuilds();
+  uint32_t buildable_sums = GetBuildableSums(index);
+  uint32_t build_mask = 0;
 
-    if (hand_[i]->GetValue() == Card::kAceOne) {
-      values.insert(Card::kAceTwo);
-    }
-
-    values.insert(hand_[i]->GetValue());
-  }
-
-  if (!MatchesCardOnTable(hand_[index]->GetValue(), table)) {
+  if (!MoveGenerator::MustCapture(hand_[index], number_, table)) {
     for (unsigned i = 0; i < builds.size(); i++) {
       if ((builds[i]->GetOwnerIndex() == number_) ||
           (builds[i]->IsMultipleBuild())) {
         continue;
       }
 
-      unsigned sum = hand_[index]->GetValue() + builds[i]->GetBuildSum();
+      unsigned sum = hand_[index].GetValue() + builds[i]->GetBuildSum();
 
-      if (values.find(sum) != values.end()) {
-        build_indices.push_back(i);
+      if (SubsetSum::SumToMask(sum) & buildable_sums) {
+        build_mask |= 1U << i;
       }
     }
   }
 
   unsigned max_index = 0;
   unsigned max_score = GetCardScore(hand_[index]);
-  std::shared_ptr<BuildNode> increase_node(new BuildNode);
+  BuildNode* increase_node = Arena::GetThreadArena().New<BuildNode>();
   increase_node->SetPlayedCardIndex(index);
   bool score_updated = false;
 
-  for (unsigned i = 0; i < build_indices.size(); i++) {
-    unsigned score = GetCardScore(hand_[index]);
-    auto deconstructed_build = table->DeconstructBuild(build_indices[i]);
-
-    for (unsigned j = 0; j < deconstructed_build.size(); j++) {
-      score += GetCardScore(deconstructed_build[j]);
-    }
+  for (uint32_t rest = build_mask; rest; rest &= rest - 1) {
+    unsigned build_index = __builtin_ctz(rest);
+    unsigned score =
+        GetCardScore(hand_[index]) + builds[build_index]->GetScore();
 
     if (score > max_score) {
       max_score = score;
-      max_index = build_indices[i];
+      max_index = build_index;
       score_updated = true;
     }
   }
@@ -734,25 +631,13 @@ std::shared_ptr<BuildNode> Player::FindBestIncreaseBuild(
 }
 
 /**
- * Description: Gets the heuristic value of a certain card.
- * Parameters: sonst std::shared_ptr<Card>& card: The card.
- * Returns: The heuristic.
+ * Description: Gets the build sums the other cards in hand could capture.
+ * Parameters: const unsigned& index: The index of the played card.
+ * Returns: A mask with bit s set when a build of sum s could be captured.
  */
 
-unsigned Player::GetCardScore(const std::shared_ptr<Card>& card) const {
-  if (card->ToString() == "DX") {
-    return 4;
-  }
-
-  if (card->IsAce()) {
-    return 3;
-  }
-
-  if (card->ToString() == "S2" || card->GetSuit() == Card::kSpades) {
-    return 2;
-  }
-
-  return 1;
+uint32_t Player::GetBuildableSums(const unsigned& index) const {
+  return MoveGenerator::GetBuildableSums(hand_, index);
 }
 
 /**
@@ -762,14 +647,9 @@ unsigned Player::GetCardScore(const std::shared_ptr<Card>& card) const {
  */
 
 void Player::ShowHint(const std::shared_ptr<Table>& table) const {
+  Arena::Scope scratch;
   auto best_capture = FindBestCapture(table);
-  bool can_capture = true;
-
-  if ((best_capture->GetLooseCardIndices().empty()) && 
-      (best_capture->GetBuildIndices().empty()) && 
-      (best_capture->GetSetIndices().empty())) {
-    can_capture = false;
-  }
+  bool can_capture = !best_capture->IsEmpty();
 
   bool can_build = true;
   auto best_build = FindBestBuild(table);
@@ -785,13 +665,13 @@ void Player::ShowHint(const std::shared_ptr<Table>& table) const {
 
   if (!can_build) {
     auto capture_card = hand_[best_capture->GetPlayedCardIndex()];
-    GUI::DisplayAiCaptureOption(best_capture, table, capture_card);
+    GUI::DisplayAiCaptureOption(*best_capture, table, capture_card);
     return;
   }
 
   if (!can_capture) {
     auto build_card = hand_[best_build->GetPlayedCardIndex()];
-    GUI::DisplayAiBuildOption(best_build, table, build_card);
+    GUI::DisplayAiBuildOption(*best_build, table, build_card);
     return;
   }
 
@@ -799,9 +679,154 @@ void Player::ShowHint(const std::shared_ptr<Table>& table) const {
   auto build_card = hand_[best_build->GetPlayedCardIndex()];
   
   if (best_capture->GetScore() > best_build->GetScore()) {
-    GUI::DisplayAiCaptureOption(best_capture, table, capture_card);
+    GUI::DisplayAiCaptureOption(*best_capture, table, capture_card);
     return;
   }
 
-  GUI::DisplayAiBuildOption(best_build, table, build_card);
+  GUI::DisplayAiBuildOption(*best_build, table, build_card);
+}
+
+/**
+ * Description: Plays a move from the MoveGenerator and records how to take it
+ *     back. Nothing is copied, so a search can apply and undo moves freely.
+ * Parameters: const Move& move: The move to play.
+ * std::shared_ptr<Table>& table: The current table state.
+ * MoveJournal& journal: The journal to record the move in.
+ * Returns: Nothing.
+ */
+
+void Player::ApplyMove(
+    const Move& move, std::shared_ptr<Table>& table, MoveJournal& journal) {
+  MoveJournal::Entry entry;
+  entry.move = move;
+  entry.loose_positions = 0;
+  entry.build_positions = 0;
+  entry.pile_size = pile_.size();
+  entry.last_captured_index = table->GetLastCapturedIndex();
+  entry.build_sum = 0;
+  entry.build_owner = 0;
+  RemoveFromHand(move.card_index);
+
+  if (move.type == Move::kTrail) {
+    table->AddLooseCard(move.card);
+  } else if (move.type == Move::kCapture) {
+    unsigned num_loose = Bitboard::Count(move.loose_mask);
+    entry.loose_positions = TakeLooseCards(move.loose_mask, table, journal);
+    const Card* taken = journal.GetSavedLooseCards(num_loose);
+
+    for (unsigned i = 0; i < num_loose; i++) {
+      AddToPile(taken[i]);
+    }
+
+    for (unsigned i = 0; i < table->GetNumBuilds(); i++) {
+      if (move.build_mask & (1U << i)) {
+        auto build = table->GetBuild(i);
+        journal.SaveBuild(build);
+
+        for (auto card : build->GetCards()) {
+          AddToPile(card);
+        }
+      }
+    }
+
+    entry.build_positions = move.build_mask;
+    table->RemoveBuildsInMask(move.build_mask);
+    AddToPile(move.card);
+    table->SetLastCapturedIndex(number_);
+  } else if (move.type == Move::kIncrease) {
+    auto build = table->GetBuild(move.build_index);
+    entry.build_sum = build->GetBuildSum();
+    entry.build_owner = build->GetOwnerIndex();
+    build->AddToSingleBuild(move.card);
+    table->UpdateBuild(
+        build, build->GetBuildSum() + move.card.GetValue(), number_);
+  } else {
+    std::vector<Card>& cards = journal.GetScratch();
+    unsigned build_sum = move.card.GetValue();
+    cards.push_back(move.card);
+
+    for (unsigned i = 0; i < table->GetNumLooseCards(); i++) {
+      if (Bitboard::Contains(move.loose_mask, table->GetLooseCard(i))) {
+        cards.push_back(table->GetLooseCard(i));
+        build_sum += table->GetLooseCard(i).GetValue();
+      }
+    }
+
+    entry.loose_positions = TakeLooseCards(move.loose_mask, table, journal);
+    std::shared_ptr<Build> build;
+
+    if (move.type == Move::kMake) {
+      build = journal.NewBuild();
+      build->SetBuildSum(build_sum);
+      build->SetOwnerIndex(number_);
+      table->AddBuild(build);
+    } else {
+      build = table->GetBuild(move.build_index);
+      entry.build_sum = build->GetBuildSum();
+      entry.build_owner = build->GetOwnerIndex();
+      table->UpdateBuild(build, build->GetBuildSum(), number_);
+    }
+
+    build->AddToBuild(cards);
+  }
+
+  journal.Push(entry);
+}
+
+/**
+ * Description: Takes back the last move played with ApplyMove, restoring the
+ *     table, hand and pile exactly.
+ * Parameters: std::shared_ptr<Table>& table: The current table state.
+ * MoveJournal& journal: The journal the move was recorded in.
+ * Returns: Nothing.
+ */
+
+void Player::UndoMove(std::shared_ptr<Table>& table, MoveJournal& journal) {
+  const MoveJournal::Entry& entry = journal.Top();
+  const Move& move = entry.move;
+  unsigned num_loose = Bitboard::Count(entry.loose_positions);
+  unsigned num_builds = __builtin_popcount(entry.build_positions);
+
+  if (move.type == Move::kTrail) {
+    table->RemoveLastLooseCard();
+  } else if (move.type == Move::kMake) {
+    auto build = table->GetBuild(table->GetNumBuilds() - 1);
+    table->RemoveLastBuild();
+    journal.RecycleBuild(build);
+  } else if (move.type != Move::kCapture) {
+    auto build = table->GetBuild(move.build_index);
+
+    if (move.type == Move::kAdd) {
+      build->RemoveLastBuild();
+    } else {
+      build->RemoveFromSingleBuild();
+    }
+
+    table->UpdateBuild(build, entry.build_sum, entry.build_owner);
+  }
+
+  if (num_builds) {
+    table->InsertBuilds(
+        entry.build_positions, journal.GetSavedBuilds(num_builds));
+    journal.DropSavedBuilds(num_builds);
+  }
+
+  if (num_loose) {
+    table->InsertLooseCards(
+        entry.loose_positions, journal.GetSavedLooseCards(num_loose));
+    journal.DropSavedLooseCards(num_loose);
+  }
+
+  while (pile_.size() > entry.pile_size) {
+    pile_mask_ &= ~Bitboard::FromCard(pile_.back());
+    pile_tally_.Remove(pile_.back());
+    hash_ ^= kZobristKeys.pile[number_ & 1][pile_.back().GetId()];
+    pile_.pop_back();
+  }
+
+  hand_.insert(hand_.begin() + move.card_index, move.card);
+  hand_mask_ |= Bitboard::FromCard(move.card);
+  hash_ ^= kZobristKeys.hand[number_ & 1][move.card.GetId()];
+  table->SetLastCapturedIndex(entry.last_captured_index);
+  journal.Pop();
 }
\ No newline at end of file
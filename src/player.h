@@ -11,69 +11,155 @@
 #include <vector>
 #include "card.h"
 #include "table.h"
+#include "deck.h"
+#include "bitboard.h"
+#include "piletally.h"
+#include "zobrist.h"
 #include "buildnode.h"
 #include "capturenode.h"
+#include "movejournal.h"
+#include "arena.h"
+#include "heuristic.h"
+#include "threadpool.h"
 
-using BuildAndLooseIndices =
-    std::vector<std::pair<unsigned, std::vector<unsigned>>>;
+using BuildAndLooseIndices = ScratchVector<std::pair<unsigned, uint64_t>>;
 
 class Player {
  public:
   // Constructors
-  Player() : score_(0), is_turn_(false), is_human_(false), number_(0) {}
+  Player() : score_(0), pile_mask_(Bitboard::kEmpty),
+      hand_mask_(Bitboard::kEmpty), is_turn_(false), is_human_(false),
+      number_(0), is_verbose_(true), hash_(0) {
+    pile_.reserve(Card::kNumCards);
+    hand_.reserve(Card::kNumCards);
+  }
 
   // Accessors
   inline unsigned GetScore() const { return score_; }
-  inline std::vector<std::shared_ptr<Card>> GetPile() const { return pile_; }
-  inline std::vector<std::shared_ptr<Card>> GetHand() const { return hand_; }
+  inline const std::vector<Card>& GetPile() const { return pile_; }
+  inline const std::vector<Card>& GetHand() const { return hand_; }
+  inline uint64_t GetPileMask() const { return pile_mask_; }
+  inline const PileTally& GetPileTally() const { return pile_tally_; }
+  inline uint64_t GetHandMask() const { return hand_mask_; }
   inline bool IsTurn() const { return is_turn_; }
   inline bool IsHuman() const { return is_human_; }
   inline unsigned GetNumber() const { return number_; }
+  inline bool IsVerbose() const { return is_verbose_; }
+  // Whether the player's last move attempt stopped to wait for input
+  virtual bool IsWaitingForInput() const { return false; }
+  inline unsigned GetNumSearchThreads() const {
+    return search_pool_ ? search_pool_->GetNumThreads() : 1;
+  }
+
+  inline uint64_t GetHash() const { return hash_; }
 
   // Mutators
   inline void SetScore(const unsigned& score) { score_ = score; } 
   inline void SetIsTurn(const bool& is_turn) { is_turn_ = is_turn; }
   inline void SetIsHuman(const bool& is_human) { is_human_ = is_human; }
-  inline void SetNumber(const unsigned& number) { number_ = number; }
-  inline void SetPile(const std::vector<std::shared_ptr<Card>>& pile) {
+  inline void SetNumber(const unsigned& number) {
+    number_ = number;
+    hash_ = HashCards(kZobristKeys.hand, hand_mask_) ^
+        HashCards(kZobristKeys.pile, pile_mask_);
+  }
+
+  inline void SetIsVerbose(const bool& is_verbose) {
+    is_verbose_ = is_verbose;
+  }
+
+  // The round in play, for players that look past their own cards
+  inline void SetOpponent(const std::shared_ptr<Player>& opponent) {
+    opponent_ = opponent;
+  }
+
+  inline void SetDeck(const std::shared_ptr<Deck>& deck) { deck_ = deck; }
+
+  // The pool to split the greedy search of each move over, which may be
+  // shared with other players, or null to search on the calling thread only.
+  // The moves chosen are the same either way
+  inline void SetSearchPool(const std::shared_ptr<ThreadPool>& search_pool) {
+    search_pool_ = search_pool;
+  }
+
+  inline void SetPile(const std::vector<Card>& pile) {
+    hash_ ^= HashCards(kZobristKeys.pile, pile_mask_);
     pile_ = pile;
+    pile_mask_ = Bitboard::FromCards(pile);
+    pile_tally_ = PileTally::FromMask(pile_mask_);
+    hash_ ^= HashCards(kZobristKeys.pile, pile_mask_);
   }
 
-  inline void SetHand(const std::vector<std::shared_ptr<Card>>& hand) {
+  inline void SetHand(const std::vector<Card>& hand) {
+    hash_ ^= HashCards(kZobristKeys.hand, hand_mask_);
     hand_ = hand;
+    hand_mask_ = Bitboard::FromCards(hand);
+    hash_ ^= HashCards(kZobristKeys.hand, hand_mask_);
   }
 
   // Public utils
   inline void AddToScore(const unsigned& num_points) { score_ += num_points; }
-  inline void AddToPile(const std::shared_ptr<Card>& card) {
+  inline void AddToPile(const Card& card) {
     pile_.push_back(card);
+    pile_mask_ |= Bitboard::FromCard(card);
+    pile_tally_.Add(card);
+    hash_ ^= kZobristKeys.pile[number_ & 1][card.GetId()];
+  }
+
+  inline void ReplaceHand(const std::vector<Card>& hand) {
+    SetHand(hand);
   }
 
-  inline void ReplaceHand(const std::vector<std::shared_ptr<Card>>& hand) {
-    hand_ =  hand;
+  inline void ClearPile() {
+    hash_ ^= HashCards(kZobristKeys.pile, pile_mask_);
+    pile_.clear();
+    pile_mask_ = Bitboard::kEmpty;
+    pile_tally_ = PileTally();
   }
 
-  inline void ClearPile() { pile_.clear(); }
-  inline void ClearHand() { hand_.clear(); }
+  inline void ClearHand() {
+    hash_ ^= HashCards(kZobristKeys.hand, hand_mask_);
+    hand_.clear();
+    hand_mask_ = Bitboard::kEmpty;
+  }
   std::string ToString() const;
-  std::shared_ptr<Card> RemoveFromHand(const unsigned& index);
+  Card RemoveFromHand(const unsigned& index);
   virtual bool MakeMove(std::shared_ptr<Table>& table) = 0;
   void ShowHint(const std::shared_ptr<Table>& table) const;
+  void ApplyMove(const Move& move, std::shared_ptr<Table>& table,
+      MoveJournal& journal);
+
+  void UndoMove(std::shared_ptr<Table>& table, MoveJournal& journal);
 
  protected:
+  // Protected constants
+  // Smaller tables search faster than the pool can hand out the work
+  static const unsigned kMinParallelTableSize = 10;
+
   unsigned score_;
-  std::vector<std::shared_ptr<Card>> pile_;
-  std::vector<std::shared_ptr<Card>> hand_;
+  std::vector<Card> pile_;
+  std::vector<Card> hand_;
+  uint64_t pile_mask_;
+  PileTally pile_tally_;
+  uint64_t hand_mask_;
   bool is_turn_;
   bool is_human_;
   unsigned number_;
+  bool is_verbose_;
+  std::weak_ptr<Player> opponent_;
+  std::weak_ptr<Deck> deck_;
+  uint64_t hash_;
+  std::shared_ptr<ThreadPool> search_pool_;
 
   // Protected utils
+  inline uint64_t HashCards(const uint64_t (&keys)[2][Card::kNumCards],
+      const uint64_t& mask) const {
+    return Zobrist::HashCards(keys[number_ & 1], mask);
+  }
+
   void TrailAction(const unsigned& card_index, std::shared_ptr<Table>& table);
   void MakeBuildAction(const unsigned& card_index,
-      const std::vector<std::shared_ptr<Card>>& cards,
-      const std::vector<unsigned>& card_indices, const unsigned& build_sum,
-      std::shared_ptr<Table>& table);
+      const std::vector<Card>& cards, const uint64_t& card_positions,
+      const unsigned& build_sum, std::shared_ptr<Table>& table);
   
   void IncreaseBuildAction(const unsigned& card_index,
       std::shared_ptr<Build>& build, const unsigned& build_sum,
@@ -81,11 +167,10 @@ class Player {
 
   void AddToBuildAction(const unsigned& card_index,
       std::shared_ptr<Build>& build,
-      const std::vector<std::shared_ptr<Card>>& cards,
-      const std::vector<unsigned>& card_indices,
+      const std::vector<Card>& cards, const uint64_t& card_positions,
       std::shared_ptr<Table>& table);
 
-  void CaptureSetAction(const std::vector<unsigned>& card_indices,
+  void CaptureSetAction(const uint64_t& card_positions,
       std::shared_ptr<Table>& table);
 
   void CaptureBuildAction(const unsigned& build_index,
@@ -97,37 +182,70 @@ class Player {
   bool CaptureAllBuildsWithSameValue(const unsigned& card_index,
       std::shared_ptr<Table>& table);
 
+  uint64_t TakeLooseCards(const uint64_t& mask, std::shared_ptr<Table>& table,
+      MoveJournal& journal);
+
   bool HasCardWithBuildSum(const unsigned& card_index,
       const unsigned& build_sum) const;
   
   bool HasMultipleOfSameCard(const unsigned& card_index) const;
-  unsigned GetCardScore(const std::shared_ptr<Card>& card) const;
-  std::vector<std::vector<unsigned>> GetAllValidSets(
-      const unsigned& value, const std::shared_ptr<Table>& table) const;
+  inline unsigned GetCardScore(const Card& card) const {
+    return kHeuristicTable.GetScore(card);
+  }
 
-  bool MatchesCardOnTable(const unsigned& value,
-      const std::shared_ptr<Table>& table) const;
+  uint32_t GetBuildableSums(const unsigned& index) const;
+  ScratchVector<uint64_t> GetAllValidSets(
+      const unsigned& value, const std::shared_ptr<Table>& table) const;
 
   bool MatchesBuildOnTable(const unsigned& value,
       const std::shared_ptr<Table>& table) const;
 
-  std::vector<std::vector<unsigned>> GetAllValidSetsOfSets(
-      const std::vector<std::vector<unsigned>>& sets) const;
+  uint64_t GetBestValidSetOfSets(const unsigned& value,
+      const std::shared_ptr<Table>& table, const uint64_t& taken,
+      unsigned& score) const;
 
-  std::shared_ptr<CaptureNode> FindBestCapture(
-      const std::shared_ptr<Table>& table) const;
+  // The Find* nodes live on the thread's arena until the caller's
+  // Arena::Scope ends
+  CaptureNode* FindBestCapture(const std::shared_ptr<Table>& table) const;
+  void FindBestCaptureWith(const unsigned& index,
+      const std::shared_ptr<Table>& table, CaptureNode& best_capture) const;
 
-  std::shared_ptr<BuildNode> FindBestBuild(
+  BuildNode* FindBestBuild(const std::shared_ptr<Table>& table) const;
+  BuildNode* FindBestSingleBuild(const unsigned& index,
       const std::shared_ptr<Table>& table) const;
 
-  std::shared_ptr<BuildNode> FindBestSingleBuild(const unsigned& index,
+  BuildNode* FindBestMultiBuild(const unsigned& index,
       const std::shared_ptr<Table>& table) const;
 
-  std::shared_ptr<BuildNode> FindBestMultiBuild(const unsigned& index,
+  BuildNode* FindBestIncreaseBuild(const unsigned& index,
       const std::shared_ptr<Table>& table) const;
 
-  std::shared_ptr<BuildNode> FindBestIncreaseBuild(const unsigned& index,
-      const std::shared_ptr<Table>& table) const;
+  // Runs task(0) to task(num_tasks - 1), on the search pool when there is
+  // one and the table is big enough to be worth it, and returns once all are
+  // done. Each task gets an Arena::Scope on the thread it runs on, so it
+  // must copy out anything it keeps.
+  template <class Task>
+  void RunSearchTasks(const std::shared_ptr<Table>& table,
+      const unsigned& num_tasks, const Task& task) const {
+    if (!search_pool_ || num_tasks < 2 ||
+        table->GetTableSize() < kMinParallelTableSize) {
+      for (unsigned i = 0; i < num_tasks; i++) {
+        Arena::Scope scratch;
+        task(i);
+      }
+
+      return;
+    }
+
+    for (unsigned i = 0; i < num_tasks; i++) {
+      search_pool_->Submit([&task, i] {
+        Arena::Scope scratch;
+        task(i);
+      });
+    }
+
+    search_pool_->Wait();
+  }
 };
 
 #endif
\ No newline at end of file
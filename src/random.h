@@ -0,0 +1,74 @@
+#ifndef _RANDOM_H_
+#define _RANDOM_H_
+
+#include <cstdint>
+
+// A small seedable generator (xoshiro256**) so every game can own its own
+// random stream instead of sharing the global rand() state.
+class Random {
+ public:
+  // Constructors
+  Random(const uint64_t& seed) { Seed(seed); }
+
+  // Public utils
+  inline void Seed(const uint64_t& seed) {
+    uint64_t state = seed;
+
+    for (unsigned i = 0; i < 4; i++) {
+      state_[i] = SplitMix(state);
+    }
+  }
+
+  inline uint64_t Next() {
+    uint64_t result = RotateLeft(state_[1] * 5, 7) * 9;
+    uint64_t shifted = state_[1] << 17;
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= shifted;
+    state_[3] = RotateLeft(state_[3], 45);
+
+    return result;
+  }
+
+  // Returns a value in [0, bound) without modulo bias
+  inline unsigned NextBelow(const unsigned& bound) {
+    uint64_t threshold = (0 - (uint64_t) bound) % bound;
+
+    while (true) {
+      uint64_t value = Next();
+
+      if (value >= threshold) {
+        return value % bound;
+      }
+    }
+  }
+
+  // Derives an independent seed for the index-th game of a batch
+  static inline uint64_t GetGameSeed(const uint64_t& seed,
+      const uint64_t& index) {
+    uint64_t state = seed ^ (index * 0xd1b54a32d192ed03ULL);
+    SplitMix(state);
+
+    return SplitMix(state);
+  }
+
+ private:
+  uint64_t state_[4];
+
+  // Private utils
+  static inline uint64_t RotateLeft(const uint64_t& value, const int& bits) {
+    return (value << bits) | (value >> (64 - bits));
+  }
+
+  static inline uint64_t SplitMix(uint64_t& state) {
+    uint64_t value = (state += 0x9e3779b97f4a7c15ULL);
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+
+    return value ^ (value >> 31);
+  }
+};
+
+#endif
\ No newline at end of file
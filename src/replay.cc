@@ -0,0 +1,208 @@
+#include "replay.h"
+#include "computer.h"
+
+const unsigned Replay::kKeyframeInterval;
+
+/**
+ * Description: Sets up the replay of a headless tournament. The seed gives the
+ *     coin toss and every deck, as in Tournament::PlayHeadless.
+ * Parameters: const uint64_t& seed: The seed the tournament was played with.
+ * const std::vector<Move>& moves: The moves of the tournament in order.
+ * Returns: Nothing.
+ */
+
+Replay::Replay(const uint64_t& seed, const std::vector<Move>& moves) :
+    moves_(moves), rng_(seed), has_seed_(true), round_num_(1), ply_(0) {
+  CreatePlayers(rng_.NextBelow(2));
+  StartRound(std::shared_ptr<Deck>(new Deck(rng_)));
+  SaveKeyframe();
+}
+
+/**
+ * Description: Sets up the replay of a round played from a saved deck. The
+ *     deck holds a single round, so the moves must not go past it.
+ * Parameters: const std::vector<std::string>& deck: The deck's card symbols,
+ *     as read by Serializer::GetDeckFromFile.
+ * const unsigned& first_player: The index of the player who moved first.
+ * const std::vector<Move>& moves: The moves of the round in order.
+ * Returns: Nothing.
+ */
+
+Replay::Replay(
+    const std::vector<std::string>& deck, const unsigned& first_player,
+    const std::vector<Move>& moves) :
+    moves_(moves), rng_(0), has_seed_(false), round_num_(1), ply_(0) {
+  CreatePlayers(first_player);
+  StartRound(std::shared_ptr<Deck>(new Deck(deck)));
+  SaveKeyframe();
+}
+
+/**
+ * Description: Fast-forwards to a ply, starting from the nearest keyframe at
+ *     or before it, and hands back the round as it stood then. The round plays
+ *     on the replay's players, so it stays live until the next seek or until
+ *     the replay is destroyed.
+ * Parameters: const unsigned& ply: The number of moves to have made.
+ * Returns: The round, or null if the ply is past the last move or the moves
+ *     do not fit the game (an invalid move, or a hash that does not match).
+ */
+
+std::shared_ptr<Round> Replay::Seek(const unsigned& ply) {
+  if (ply > moves_.size()) {
+    return nullptr;
+  }
+
+  unsigned index = ply / kKeyframeInterval;
+  LoadKeyframe(index < keyframes_.size() ? index : keyframes_.size() - 1);
+
+  while (ply_ < ply) {
+    if (!Step()) {
+      return nullptr;
+    }
+  }
+
+  return round_;
+}
+
+/**
+ * Description: Collects one game's moves from a move log.
+ * Parameters: const std::string& file_name: The move log.
+ * const uint64_t& game_id: The game to collect.
+ * std::vector<Move>& moves: An input parameter set to the moves by ply.
+ * std::vector<uint64_t>& hashes: An input parameter set to the logged hash
+ *     after each move.
+ * Returns: Whether the log holds the game with no ply missing.
+ */
+
+bool Replay::ReadMoves(
+    const std::string& file_name, const uint64_t& game_id,
+    std::vector<Move>& moves, std::vector<uint64_t>& hashes) {
+  MoveLogReader reader(file_name);
+  MoveLog::Record record;
+  std::vector<bool> seen;
+  moves.clear();
+  hashes.clear();
+
+  if (!reader.IsOpen()) {
+    return false;
+  }
+
+  while (reader.Next(record)) {
+    if (record.game_id != game_id) {
+      continue;
+    }
+
+    if (record.ply >= moves.size()) {
+      moves.resize(record.ply + 1);
+      hashes.resize(record.ply + 1);
+      seen.resize(record.ply + 1);
+    }
+
+    moves[record.ply] = record.move;
+    hashes[record.ply] = record.hash;
+    seen[record.ply] = true;
+  }
+
+  for (unsigned i = 0; i < seen.size(); i++) {
+    if (!seen[i]) {
+      return false;
+    }
+  }
+
+  return !moves.empty();
+}
+
+/**
+ * Description: Creates the two computer players the moves are replayed on.
+ * Parameters: const unsigned& first_player: The index of the player to move
+ *     first.
+ * Returns: Nothing.
+ */
+
+void Replay::CreatePlayers(const unsigned& first_player) {
+  for (unsigned i = 0; i < 2; i++) {
+    players_.push_back(std::shared_ptr<Player>(new Computer));
+    players_[i]->SetIsHuman(false);
+    players_[i]->SetIsVerbose(false);
+    players_[i]->SetNumber(i);
+    players_[i]->SetIsTurn(i == first_player);
+  }
+}
+
+/**
+ * Description: Deals a new round from a deck.
+ * Parameters: std::shared_ptr<Deck> deck: The deck.
+ * Returns: Nothing.
+ */
+
+void Replay::StartRound(std::shared_ptr<Deck> deck) {
+  round_ = std::shared_ptr<Round>(new Round(players_, deck, round_num_++));
+}
+
+/**
+ * Description: Replays the next move, finishing the round and dealing the next
+ *     one from the seed first if the round is over. Every kKeyframeInterval
+ *     plies the first time through, the position is kept as a keyframe.
+ * Parameters: None.
+ * Returns: Whether the move was made and led to the logged hash, if any.
+ */
+
+bool Replay::Step() {
+  if (!round_->PrepareMove()) {
+    if (!has_seed_) {
+      return false;
+    }
+
+    round_->Step(Round::kAdvance);
+    StartRound(std::shared_ptr<Deck>(new Deck(rng_)));
+  }
+
+  if (!round_->ReplayMove(moves_[ply_], journal_)) {
+    return false;
+  }
+
+  journal_.Clear();
+
+  if (!hashes_.empty() && round_->GetHash() != hashes_[ply_]) {
+    return false;
+  }
+
+  ply_++;
+
+  if (ply_ == keyframes_.size() * kKeyframeInterval) {
+    SaveKeyframe();
+  }
+
+  return true;
+}
+
+/**
+ * Description: Snapshots the current round and the seed's generator.
+ * Parameters: None.
+ * Returns: Nothing.
+ */
+
+void Replay::SaveKeyframe() {
+  keyframes_.push_back(Keyframe{rng_, 0, {}});
+  keyframes_.back().size = round_->GetBinaryData(keyframes_.back().data);
+}
+
+/**
+ * Description: Restores the round and generator from a keyframe.
+ * Parameters: const unsigned& index: The keyframe, which is at ply
+ *     index * kKeyframeInterval.
+ * Returns: Nothing.
+ */
+
+void Replay::LoadKeyframe(const unsigned& index) {
+  const Keyframe& keyframe = keyframes_[index];
+  std::shared_ptr<Table> table;
+  std::shared_ptr<Deck> deck;
+  unsigned next_player;
+  Serializer::ReadBinaryRound(keyframe.data, keyframe.size, players_,
+      round_num_, table, deck, next_player);
+  round_ = std::shared_ptr<Round>(
+      new Round(players_, table, deck, next_player, round_num_++));
+  rng_ = keyframe.rng;
+  ply_ = index * kKeyframeInterval;
+}
\ No newline at end of file
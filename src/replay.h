@@ -0,0 +1,75 @@
+#ifndef _REPLAY_H_
+#define _REPLAY_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "round.h"
+#include "random.h"
+#include "serializer.h"
+
+// Rebuilds any ply of a recorded game from how it started (the game's seed,
+// or a saved deck) and its moves. Moves are replayed with Player::ApplyMove,
+// so a seek costs one cheap step per move, and a binary snapshot of the round
+// is kept every kKeyframeInterval plies so a seek only replays the moves made
+// since the nearest one.
+class Replay {
+ public:
+  // Public constants
+  static const unsigned kKeyframeInterval = 32;
+
+  // Delete copy constructor and assignment operator
+  Replay(const Replay& replay) = delete;
+  Replay& operator=(const Replay& replay) = delete;
+
+  // Constructors
+  Replay(const uint64_t& seed, const std::vector<Move>& moves);
+  Replay(const std::vector<std::string>& deck, const unsigned& first_player,
+      const std::vector<Move>& moves);
+
+  // Accessors
+  inline unsigned GetNumPlies() const { return moves_.size(); }
+  inline unsigned GetPly() const { return ply_; }
+  inline unsigned GetNumKeyframes() const { return keyframes_.size(); }
+
+  // Mutators
+  // Checks every move against its logged hash. Keyframes already made past
+  // the start are dropped so that seeks check the moves before them again
+  inline void SetHashes(const std::vector<uint64_t>& hashes) {
+    hashes_ = hashes;
+    keyframes_.erase(keyframes_.begin() + 1, keyframes_.end());
+  }
+
+  // Public utils
+  std::shared_ptr<Round> Seek(const unsigned& ply);
+  static bool ReadMoves(const std::string& file_name, const uint64_t& game_id,
+      std::vector<Move>& moves, std::vector<uint64_t>& hashes);
+
+ private:
+  // Private structs
+  struct Keyframe {
+    Random rng;
+    unsigned size;
+    uint8_t data[Serializer::kMaxBinarySize];
+  };
+
+  std::vector<std::shared_ptr<Player>> players_;
+  std::vector<Move> moves_;
+  std::vector<uint64_t> hashes_;
+  std::vector<Keyframe> keyframes_;
+  std::shared_ptr<Round> round_;
+  MoveJournal journal_;
+  Random rng_;
+  bool has_seed_;
+  unsigned round_num_;
+  unsigned ply_;
+
+  // Private utils
+  void CreatePlayers(const unsigned& first_player);
+  void StartRound(std::shared_ptr<Deck> deck);
+  bool Step();
+  void SaveKeyframe();
+  void LoadKeyframe(const unsigned& index);
+};
+
+#endif
\ No newline at end of file
@@ -1,6 +1,8 @@
+#include <chrono>
 #include "round.h"
 #include "inputhandler.h"
 #include "gui.h"
+#include "movegenerator.h"
 #include "serializer.h"
 
 /**
@@ -14,10 +16,29 @@
 Round::Round(
     std::vector<std::shared_ptr<Player>>& players,
     const unsigned& round_num) :
-    players_(players), round_num_(round_num) {
+    players_(players), state_(kDealing), round_num_(round_num), game_id_(0),
+    ply_(0) {
   InitRound();
 }
 
+/**
+ * Description: Constructor that initializes a fresh round from a given deck
+ *     without prompting for input.
+ * Parameters: std::vector<std::shared_ptr<Player>>& players: The players
+ *     received from the tournament.
+ * std::shared_ptr<Deck>& deck: The deck to deal from.
+ * const unsigned& round_num: The round number to start with.
+ * Returns: Nothing.
+ */
+
+Round::Round(
+    std::vector<std::shared_ptr<Player>>& players,
+    std::shared_ptr<Deck>& deck, const unsigned& round_num) :
+    players_(players), deck_(deck), state_(kDealing), round_num_(round_num),
+    game_id_(0), ply_(0) {
+  SetUpRound();
+}
+
 /**
  * Description: Constructor that initializes a loaded round.
  * Parameters: std::vector<std::shared_ptr<Player>>& players: The players
@@ -32,8 +53,9 @@ Round::Round(
     std::vector<std::shared_ptr<Player>>& players,
     std::shared_ptr<Table>& table, std::shared_ptr<Deck>& deck,
     const unsigned& current_player_index, const unsigned& round_num) :
-    players_(players), table_(table), deck_(deck),
-    current_player_index_(current_player_index), round_num_(round_num) {
+    players_(players), table_(table), deck_(deck), state_(kDealing),
+    current_player_index_(current_player_index), round_num_(round_num),
+    game_id_(0), ply_(0) {
   if (current_player_index_) {
     players_[0]->SetIsTurn(false);
     players_[1]->SetIsTurn(true);
@@ -41,23 +63,29 @@ Round::Round(
     players_[1]->SetIsTurn(false);
     players_[0]->SetIsTurn(true);
   }
+
+  ShareRoundState();
 }
 
 /**
  * Description: Handles menu input.
  * Parameters: const unsigned& choice: The menu directive chosen.
- * Returns: Whether to switch turns or not. Exits if the choice was save or
- *     quit
+ * Returns: Whether to switch turns or not, which it is not if the prompt was
+ *     suspended. Exits if the choice was save or quit
  */
 
 bool Round::HandleMenuInput(const unsigned& choice) {
+  if (InputHandler::IsSuspended()) {
+    return false;
+  }
+
   if (choice == kSave) {
     Serializer::SaveRoundState(InputHandler::GetFileInput(), this);
     exit(0);
   }
 
   if (choice == kMove) {
-    return players_[current_player_index_]->MakeMove(table_);
+    return MakeMove();
   }
 
   if (choice == kHelp) {
@@ -87,6 +115,16 @@ void Round::InitRound() {
         new Deck(Serializer::GetDeckFromFile(InputHandler::GetFileInput())));
   }
 
+  SetUpRound();
+}
+
+/**
+ * Description: Clears the players and deals the opening cards from the deck.
+ * Parameters: None.
+ * Returns: Nothing.
+ */
+
+void Round::SetUpRound() {
   table_ = std::shared_ptr<Table>(new Table);
   current_player_index_ = (players_[0]->IsTurn() ? 0 : 1);
 
@@ -97,6 +135,21 @@ void Round::InitRound() {
 
   DealCards();
   table_->AddDealtCards(deck_->DealNext());
+  ShareRoundState();
+}
+
+/**
+ * Description: Tells each player who it plays against and which deck is in
+ *     use, so a searching computer can count the unseen cards.
+ * Parameters: None.
+ * Returns: Nothing.
+ */
+
+void Round::ShareRoundState() {
+  for (unsigned i = 0; i < players_.size(); i++) {
+    players_[i]->SetOpponent(players_[(i + 1) % players_.size()]);
+    players_[i]->SetDeck(deck_);
+  }
 }
 
 /**
@@ -115,6 +168,42 @@ void Round::DealCards() {
   }
 }
 
+/**
+ * Description: Lets the current player move and, if the round has a move log,
+ *     appends the move to it.
+ * Parameters: None.
+ * Returns: Whether the player moved.
+ */
+
+bool Round::MakeMove() {
+  auto player = players_[current_player_index_];
+
+  if (!move_log_) {
+    return player->MakeMove(table_);
+  }
+
+  MoveLog::SaveBefore(*player, *table_, before_move_);
+
+  if (!player->MakeMove(table_)) {
+    return false;
+  }
+
+  move_log_->Append(game_id_, ply_++,
+      MoveLog::GetPlayedMove(before_move_, *player, *table_), GetHash());
+
+  return true;
+}
+
+/**
+ * Description: Hashes the cards of both players and the table.
+ * Parameters: None.
+ * Returns: The hash.
+ */
+
+uint64_t Round::GetHash() const {
+  return players_[0]->GetHash() ^ players_[1]->GetHash() ^ table_->GetHash();
+}
+
 /**
  * Description: Switches the turns.
  * Parameters: None.
@@ -150,52 +239,55 @@ bool Round::AllHandsEmpty() {
 }
 
 /**
- * Description: Plays a fresh round.
+ * Description: Plays the round until it is over. If its input can suspend
+ *     and runs out, it returns instead, and the next call resumes the round
+ *     where it stopped.
  * Parameters: None.
  * Returns: Nothing.
  */
 
 void Round::PlayRound() {
-  GUI::DisplayRoundStartMessage();
+  StreamScope streams(*this);
 
-  while (true) {
-    if (AllHandsEmpty()) {
-      if (deck_->IsEmpty()) {
-        break;
-      }
+  // A round being resumed has already started, and is waiting on a move
+  if (state_ == kDealing) {
+    GUI::DisplayRoundStartMessage();
+  }
 
+  while (state_ != kOver) {
+    if (state_ == kDealing && AllHandsEmpty() && !deck_->IsEmpty()) {
       GUI::DisplayAllHandsEmptyMessage();
-      DealCards();
     }
 
-    GUI::DisplayPlayerTurnMessage(players_);
-    GUI::DisplayAllPlayerInfo(players_);
-    GUI::DisplayTable(table_);
-    GUI::DisplayDeck(deck_);
+    if (state_ != kMoving) {
+      if (Step(kAdvance) == kDealing) {
+        GUI::DisplayTurnSwitchMessage();
+      }
 
-    if (!HandleMenuInput(InputHandler::GetMenuInput())) {
       continue;
     }
 
-    SwitchTurn();
-    GUI::DisplayTurnSwitchMessage();
-  }
-
-  CalcScores();
-  auto to_pile = table_->ClearTable();
-  unsigned last_captured_index = table_->GetLastCapturedIndex();
-
-  for (unsigned i = 0; i < to_pile.size(); i++) {
-    players_[last_captured_index]->AddToPile(to_pile[i]);
-  }
+    // A move whose input ran out part way goes on without the menu
+    if (IsWaitingForInput()) {
+      Step(kAdvance);
+    } else {
+      GUI::DisplayPlayerTurnMessage(players_);
+      GUI::DisplayAllPlayerInfo(players_);
+      GUI::DisplayTable(table_);
+      GUI::DisplayDeck(deck_);
+      bool is_moved = HandleMenuInput(InputHandler::GetMenuInput());
+
+      if (InputHandler::IsSuspended()) {
+        GUI::GetSink().Flush();
+        return;
+      }
 
-  for (unsigned i = 0; i < players_.size(); i++) {
-    if (i == last_captured_index) {
-      players_[i]->SetIsTurn(true);
-      continue;
+      Step(is_moved ? kMoveMade : kMoveSkipped);
     }
 
-    players_[i]->SetIsTurn(false);
+    if (IsWaitingForInput()) {
+      return;
+    }
   }
 
   GUI::DisplayPlayerPiles(players_);
@@ -204,57 +296,207 @@ void Round::PlayRound() {
     GUI::DisplayNumPoints(players_[i]);
     GUI::DisplayNumCards(players_[i]);
   }
+
+  GUI::GetSink().Flush();
 }
 
 /**
- * Description: Gets the index of the player that got the most cards.
- * Parameters: None.
- * Returns: The index.
+ * Description: Plays a fresh round without any input or output. Every player
+ *     must be able to move on its own (no humans).
+ * Parameters: LatencyHistogram& move_latency: Records how long each move took.
+ * Returns: The number of moves made.
  */
 
-unsigned Round::GetMaxCardsIndex() {
-  unsigned max_cards = 0;
-  unsigned max_index = 0;
+unsigned Round::PlayHeadless(LatencyHistogram& move_latency) {
+  StreamScope streams(*this);
+  unsigned num_moves = 0;
 
-  for (unsigned i = 0; i < players_.size(); i++) {
-    unsigned pile_size = players_[i]->GetPile().size();
+  while (state_ != kOver) {
+    if (state_ != kMoving) {
+      Step(kAdvance);
+      continue;
+    }
 
-    if (pile_size > max_cards) {
-      max_cards = pile_size;
-      max_index = i;
+    auto start = std::chrono::steady_clock::now();
+    State next = Step(kAdvance);
+    auto end = std::chrono::steady_clock::now();
+    move_latency.Record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        end - start).count());
+
+    if (next == kSwitchingTurn) {
+      num_moves++;
     }
   }
 
-  return max_index;
+  return num_moves;
 }
 
 /**
- * Description: Gets the index of the player that got the most spades.
+ * Description: Takes the round one step through its states.
+ *     kDealing deals new hands if every hand is empty, then goes to kMoving,
+ *     or to kScoring if the deck is empty too. kMoving goes to kSwitchingTurn
+ *     once the player to move has moved: on kAdvance the player is asked for
+ *     its move, and kMoveMade or kMoveSkipped report a move made, or not,
+ *     elsewhere. kSwitchingTurn passes the turn and goes back to kDealing.
+ *     kScoring scores the round, clears the table and goes to kOver. A
+ *     human whose input has run out leaves the round in kMoving, waiting for
+ *     input (see IsWaitingForInput), and is resumed by the next kAdvance.
+ * Parameters: const Event& event: What happened since the last step.
+ * Returns: The state the round is now in.
+ */
+
+Round::State Round::Step(const Event& event) {
+  StreamScope streams(*this);
+  State previous = state_;
+
+  switch (state_) {
+    case kDealing:
+      state_ = Deal();
+      break;
+    case kMoving:
+      if (event == kMoveMade || (event == kAdvance && MakeMove())) {
+        state_ = kSwitchingTurn;
+      }
+
+      break;
+    case kSwitchingTurn:
+      SwitchTurn();
+      state_ = kDealing;
+      break;
+    case kScoring:
+      FinishRound();
+      state_ = kOver;
+      break;
+    case kOver:
+      break;
+  }
+
+  if (previous == kSwitchingTurn || state_ == kOver || IsWaitingForInput()) {
+    GUI::GetSink().Flush();
+  }
+
+  return state_;
+}
+
+/**
+ * Description: Points the thread's prompts and messages at a round's streams.
+ * Parameters: const Round& round: The round.
+ * Returns: Nothing.
+ */
+
+Round::StreamScope::StreamScope(const Round& round) :
+    input(InputHandler::GetSource()), output(&GUI::GetSink()) {
+  InputHandler::SetSource(round.input_);
+  GUI::SetSink(round.output_.get());
+}
+
+/**
+ * Description: Points the thread's prompts and messages back where they were.
  * Parameters: None.
- * Returns: The index.
+ * Returns: Nothing.
  */
 
-unsigned Round::GetMaxSpadesIndex() {
-  unsigned max_spades = 0;
-  unsigned max_index = 0;
+Round::StreamScope::~StreamScope() {
+  InputHandler::SetSource(input);
+  GUI::SetSink(output);
+}
 
-  for (unsigned i = 0; i < players_.size(); i++) {
-    auto pile = players_[i]->GetPile();
-    unsigned num_spades = 0;
+/**
+ * Description: Makes a recorded move for the current player, dealing first if
+ *     the hands are empty, exactly as PlayHeadless would have. The move is
+ *     checked against the generated moves first, since a log or a peer may
+ *     send anything.
+ * Parameters: const Move& move: The recorded move.
+ * MoveJournal& journal: The journal to apply the move through.
+ * Returns: Whether the move was made. It is not once the round is over, which
+ *     leaves the round in kScoring for the caller to step, or if the move is
+ *     not one the current player can make, which leaves the round in kMoving.
+ */
 
-    for (unsigned j = 0; j < pile.size(); j++) {
-      if (pile[j]->GetValue() == Card::kSpades) {
-        num_spades++;
-      }
-    }
+bool Round::ReplayMove(const Move& move, MoveJournal& journal) {
+  if (!PrepareMove()) {
+    return false;
+  }
+
+  const auto& player = players_[current_player_index_];
+  const MoveList& moves = MoveGenerator::GenerateOnThread(
+      player->GetHand(), player->GetNumber(), table_);
+  unsigned i = 0;
+
+  while (i < moves.GetSize() && !(moves[i] == move)) {
+    i++;
+  }
+
+  if (i == moves.GetSize()) {
+    return false;
+  }
+
+  player->ApplyMove(moves[i], table_, journal);
+  ply_++;
+  Step(kMoveMade);
+  Step(kAdvance);
+
+  return true;
+}
+
+/**
+ * Description: Steps the round up to the current player's next move, dealing
+ *     new hands if every hand has been played out.
+ * Parameters: None.
+ * Returns: Whether there is a move to make. There is not once the hands and
+ *     the deck are empty, which leaves the round in kScoring.
+ */
+
+bool Round::PrepareMove() {
+  while (state_ == kDealing || state_ == kSwitchingTurn) {
+    Step(kAdvance);
+  }
+
+  return state_ == kMoving;
+}
+
+/**
+ * Description: Deals new hands if every hand is empty.
+ * Parameters: None.
+ * Returns: The state to go to: kMoving, or kScoring once the deck is out.
+ */
 
-    if (num_spades > max_spades) {
-      max_spades = num_spades;
-      max_index = i;
+Round::State Round::Deal() {
+  if (AllHandsEmpty()) {
+    if (deck_->IsEmpty()) {
+      return kScoring;
     }
+
+    DealCards();
   }
 
-  return max_index;
+  return kMoving;
+}
+
+/**
+ * Description: Scores the round and gives the leftover table cards to the
+ *     player who captured last.
+ * Parameters: None.
+ * Returns: Nothing.
+ */
+
+void Round::FinishRound() {
+  CalcScores();
+  auto to_pile = table_->ClearTable();
+  unsigned last_captured_index = table_->GetLastCapturedIndex();
+
+  for (unsigned i = 0; i < to_pile.size(); i++) {
+    players_[last_captured_index]->AddToPile(to_pile[i]);
+  }
+
+  for (unsigned i = 0; i < players_.size(); i++) {
+    if (i == last_captured_index) {
+      players_[i]->SetIsTurn(true);
+      continue;
+    }
+
+    players_[i]->SetIsTurn(false);
+  }
 }
 
 /**
@@ -264,29 +506,40 @@ unsigned Round::GetMaxSpadesIndex() {
  */
 
 void Round::CalcScores() {
-  bool card_tie = false;
+  PileTally piles[2];
+  unsigned points[2];
 
-  if (players_[0]->GetPile().size() == Deck::kMaxDeckSize / players_.size()) {
-    card_tie = true;
+  for (unsigned i = 0; i < players_.size(); i++) {
+    piles[i] = players_[i]->GetPileTally();
   }
 
-  if (!card_tie) {
-    players_[GetMaxCardsIndex()]->AddToScore(3);
+  ScorePiles(piles, points);
+
+  for (unsigned i = 0; i < players_.size(); i++) {
+    players_[i]->AddToScore(points[i]);
   }
+}
 
-  players_[GetMaxSpadesIndex()]->AddToScore(1);
+/**
+ * Description: Scores two piles at the end of a round. Most cards is worth 3
+ *     (nothing on a 26 to 26 tie), most spades 1, the ten of diamonds 2, and
+ *     the two of spades and each ace 1. Ties for most go to the first pile.
+ * Parameters: const PileTally* piles: The tallies of the two piles.
+ * unsigned* points: An input parameter to fill out with the points of each
+ *     pile.
+ * Returns: Nothing.
+ */
 
-  for (unsigned i = 0; i < players_.size(); i++) {
-    auto pile = players_[i]->GetPile();
+void Round::ScorePiles(const PileTally* piles, unsigned* points) {
+  for (unsigned i = 0; i < 2; i++) {
+    points[i] = piles[i].num_points;
+  }
 
-    for (unsigned j = 0; j < pile.size(); j++) {
-      if (pile[j]->ToString() == "DX") {
-        players_[i]->AddToScore(2);
-      } else if (pile[j]->ToString() == "S2" || pile[j]->IsAce()) {
-        players_[i]->AddToScore(1);
-      }
-    }
+  if (piles[0].num_cards != Deck::kMaxDeckSize / 2) {
+    points[piles[1].num_cards > piles[0].num_cards ? 1 : 0] += 3;
   }
+
+  points[piles[1].num_spades > piles[0].num_spades ? 1 : 0] += 1;
 }
 
 /**
@@ -305,8 +558,8 @@ std::string Round::GetRoundData() {
 
   data += table_->ToString() + '\n';
 
-  for (unsigned i = 0; i < table_->GetCurrentBuilds().size(); i++) {
-    auto build = table_->GetCurrentBuilds()[i];
+  for (unsigned i = 0; i < table_->GetNumBuilds(); i++) {
+    const auto& build = table_->GetBuild(i);
     data += "Build Owner: " + build->ToString()
          + (build->GetOwnerIndex() ? "Human\n" : "Computer\n");
   }
@@ -317,4 +570,16 @@ std::string Round::GetRoundData() {
       (players_[current_player_index_]->IsHuman() ? "Human\n" : "Computer\n");
 
   return data;
+}
+
+/**
+ * Description: Serializes the round into the compact binary format.
+ * Parameters: uint8_t* buffer: The buffer to write to, at least
+ *     Serializer::kMaxBinarySize bytes.
+ * Returns: The number of bytes written.
+ */
+
+unsigned Round::GetBinaryData(uint8_t* buffer) const {
+  return Serializer::WriteBinaryRound(
+      round_num_, players_, table_, *deck_, current_player_index_, buffer);
 }
\ No newline at end of file
@@ -4,25 +4,105 @@
 #include "player.h"
 #include "table.h"
 #include "deck.h"
-#include "round.h"
+#include "latencyhistogram.h"
+#include "movelog.h"
+#include "movejournal.h"
+#include "inputsource.h"
+#include "outputsink.h"
 
+// A round is a state machine. Step takes it from one state to the next:
+// dealing new hands (or moving on to scoring once the deck is empty), the
+// player to move making its move, switching turns, and scoring the round and
+// clearing the table. Nothing blocks between steps, so a caller can interleave
+// as many rounds as it likes on one thread.
 class Round {
  public:
+  // Public enums
+  enum State {
+    kDealing = 1,
+    kMoving,
+    kSwitchingTurn,
+    kScoring,
+    kOver
+  };
+
+  enum Event {
+    // Do whatever the current state does next on its own. While moving, the
+    // player to move is asked for its move
+    kAdvance = 1,
+    // The player to move moved by other means, e.g. a replayed move
+    kMoveMade,
+    // The player to move did not move, e.g. it asked for a hint
+    kMoveSkipped
+  };
+
   // Delete copy constructor and assignment operator
   Round(const Round& round) = delete;
   Round& operator=(const Round& round) = delete;
 
   // Constructors
   Round(std::vector<std::shared_ptr<Player>>& players, const unsigned& round_num);
+  Round(std::vector<std::shared_ptr<Player>>& players,
+      std::shared_ptr<Deck>& deck, const unsigned& round_num);
   Round(std::vector<std::shared_ptr<Player>>& players, std::shared_ptr<Table>& table,
       std::shared_ptr<Deck>& deck, const unsigned& current_player_index,
       const unsigned& round_num);
 
+  // Accessors
+  inline State GetState() const { return state_; }
+  inline bool IsWaitingForInput() const {
+    return state_ == kMoving &&
+        players_[current_player_index_]->IsWaitingForInput();
+  }
+
+  inline unsigned GetPly() const { return ply_; }
+  inline const std::shared_ptr<Table>& GetTable() const { return table_; }
+  inline const std::shared_ptr<Player>& GetCurrentPlayer() const {
+    return players_[current_player_index_];
+  }
+
+  uint64_t GetHash() const;
+
+  // Mutators
+  // Where the round's prompts read from and its messages go, instead of the
+  // console. Output is flushed at every turn boundary
+  inline void SetInput(const std::shared_ptr<InputSource>& input) {
+    input_ = input;
+  }
+
+  inline void SetOutput(const std::shared_ptr<OutputSink>& output) {
+    output_ = output;
+  }
+
+  inline void SetMoveLog(const std::shared_ptr<MoveLog>& move_log,
+      const uint64_t& game_id, const unsigned& ply) {
+    move_log_ = move_log;
+    game_id_ = game_id;
+    ply_ = ply;
+  }
+
   // Public utils
   std::string GetRoundData();
+  unsigned GetBinaryData(uint8_t* buffer) const;
   void PlayRound();
+  unsigned PlayHeadless(LatencyHistogram& move_latency);
+  State Step(const Event& event);
+  bool PrepareMove();
+  bool ReplayMove(const Move& move, MoveJournal& journal);
+  static void ScorePiles(const PileTally* piles, unsigned* points);
 
  private:
+  // Private structs
+  // Points the thread's prompts and messages at the round's streams while it
+  // is in scope
+  struct StreamScope {
+    StreamScope(const Round& round);
+    ~StreamScope();
+
+    std::shared_ptr<InputSource> input;
+    OutputSink* output;
+  };
+
   // Private enums
   enum MenuChoice {
     kSave = 1,
@@ -39,18 +119,28 @@ class Round {
   std::vector<std::shared_ptr<Player>>& players_;
   std::shared_ptr<Table> table_;
   std::shared_ptr<Deck> deck_;
+  State state_;
   unsigned current_player_index_;
   unsigned last_captured_index_;
   unsigned round_num_;
+  std::shared_ptr<MoveLog> move_log_;
+  uint64_t game_id_;
+  unsigned ply_;
+  MoveLog::Before before_move_;
+  std::shared_ptr<InputSource> input_;
+  std::shared_ptr<OutputSink> output_;
 
   // Private utils
   bool HandleMenuInput(const unsigned& choice);
   void InitRound();
+  void SetUpRound();
+  void ShareRoundState();
+  bool MakeMove();
   void SwitchTurn();
   void DealCards();
   bool AllHandsEmpty();
-  unsigned GetMaxCardsIndex();
-  unsigned GetMaxSpadesIndex();
+  State Deal();
+  void FinishRound();
   void CalcScores();
 };
 
@@ -10,18 +10,36 @@
 #include "serializer.h"
 #include "sanitizer.h"
 #include "gui.h"
+#include "computer.h"
+
+const char Serializer::kBinaryMagic[] = "CS";
+const char Serializer::kBinaryExtension[] = ".bin";
+const unsigned Serializer::kFieldBits;
 
 /**
- * Description: Saves the current state of the round.
+ * Description: Saves the current state of the round, in the binary format if
+ *     the file name ends in .bin and in the text format otherwise.
  * Parameters: const std::string& file_name: The file name to save to.
  * Round* round: The round state (regular pointer passed because it is *this).
- * Returns: Nothing.
+ * Returns: Whether the file was written.
  */
 
-void Serializer::SaveRoundState(const std::string& file_name, Round* round) {
+bool Serializer::SaveRoundState(const std::string& file_name, Round* round) {
+  if (HasBinaryExtension(file_name)) {
+    uint8_t buffer[kMaxBinarySize];
+    unsigned size = round->GetBinaryData(buffer);
+    std::ofstream out_file(file_name, std::ios::binary);
+    out_file.write((const char*) buffer, size);
+    out_file.close();
+
+    return !out_file.fail();
+  }
+
   std::ofstream out_file(file_name); 
   out_file << round->GetRoundData();
   out_file.close();
+
+  return !out_file.fail();
 }
 
 /**
@@ -112,17 +130,17 @@ unsigned Serializer::GetPlayerScoreFromFile(std::ifstream& in_file) {
  * Returns: A vector of cards.
  */
 
-std::vector<std::shared_ptr<Card>> Serializer::GetCardsFromFile(
+std::vector<Card> Serializer::GetCardsFromFile(
     std::ifstream& in_file) {
   std::string line;
   std::getline(in_file, line);
   unsigned split_index = line.find(':');
   std::vector<std::string> str_cards =
       Sanitizer::TokenizeInput(line.substr(split_index + 2));
-  std::vector<std::shared_ptr<Card>> cards;
+  std::vector<Card> cards;
 
   for (unsigned i = 0; i < str_cards.size(); i++) {
-    cards.push_back(std::shared_ptr<Card>(new Card(str_cards[i])));
+    cards.push_back(Card(str_cards[i]));
   }
 
   return cards;
@@ -161,12 +179,12 @@ std::vector<std::shared_ptr<Build>> Serializer::GetBuildsFromFile(
         std::vector<std::string> build_str =
             Sanitizer::TokenizeInput(
                 actual_build.substr(top_index + 1, i - top_index - 1));
-        std::vector<std::shared_ptr<Card>> cards;
+        std::vector<Card> cards;
         unsigned build_sum = 0;
 
         for (unsigned i = 0; i < build_str.size(); i++) {
-          cards.push_back(std::shared_ptr<Card>(new Card(build_str[i])));
-          build_sum += cards[i]->GetValue();
+          cards.push_back(Card(build_str[i]));
+          build_sum += cards[i].GetValue();
         }
 
         build->AddToBuild(cards);
@@ -187,9 +205,9 @@ std::vector<std::shared_ptr<Build>> Serializer::GetBuildsFromFile(
  * Returns: A vector of cards.
  */
 
-std::vector<std::shared_ptr<Card>> Serializer::GetLooseCardsFromFile(
+std::vector<Card> Serializer::GetLooseCardsFromFile(
     std::ifstream& in_file) {
-  std::vector<std::shared_ptr<Card>> loose_cards;
+  std::vector<Card> loose_cards;
   std::string line;
   std::getline(in_file, line);
   std::size_t end_build_index = line.find_last_of(']');
@@ -198,7 +216,7 @@ std::vector<std::shared_ptr<Card>> Serializer::GetLooseCardsFromFile(
   unsigned start_iter = (end_build_index == std::string::npos ? 1 : 0);
 
   for (unsigned i = start_iter; i < str_loose_cards.size(); i++) {
-    loose_cards.push_back(std::shared_ptr<Card>(new Card(str_loose_cards[i])));
+    loose_cards.push_back(Card(str_loose_cards[i]));
   }
 
   return loose_cards;
@@ -211,7 +229,7 @@ std::vector<std::shared_ptr<Card>> Serializer::GetLooseCardsFromFile(
  */
 
 std::shared_ptr<Deck> Serializer::GetDeckFromFile(std::ifstream& in_file) {
-  std::vector<std::shared_ptr<Card>> cards = GetCardsFromFile(in_file);
+  std::vector<Card> cards = GetCardsFromFile(in_file);
   std::reverse(cards.begin(), cards.end());
 
   return std::shared_ptr<Deck>(new Deck(cards));
@@ -229,4 +247,386 @@ unsigned Serializer::GetNextPlayerFromFile(std::ifstream& in_file) {
   unsigned split_index = line.find(':');
 
   return (line.substr(split_index + 2) == "Human" ? 1 : 0);
+}
+
+/**
+ * Description: Reads a saved round in either format, telling them apart by
+ *     the binary format's leading bytes.
+ * Parameters: const std::string& file_name: The file name to read from.
+ * std::vector<std::shared_ptr<Player>>& players: The players to fill in.
+ * unsigned& round_num: An input parameter set to the round number.
+ * std::shared_ptr<Table>& table: An input parameter set to the table.
+ * std::shared_ptr<Deck>& deck: An input parameter set to the deck.
+ * unsigned& next_player: An input parameter set to the next player's index.
+ * Returns: Whether the file could be opened and, if binary, was valid.
+ */
+
+bool Serializer::ReadRoundState(
+    const std::string& file_name,
+    std::vector<std::shared_ptr<Player>>& players, unsigned& round_num,
+    std::shared_ptr<Table>& table, std::shared_ptr<Deck>& deck,
+    unsigned& next_player) {
+  std::ifstream in_file(file_name);
+
+  if (!in_file.good()) {
+    return false;
+  }
+
+  uint8_t buffer[kMaxBinarySize + 1];
+  in_file.read((char*) buffer, sizeof(buffer));
+  unsigned size = in_file.gcount();
+
+  if (size >= 2 && buffer[0] == kBinaryMagic[0] &&
+      buffer[1] == kBinaryMagic[1]) {
+    return size <= kMaxBinarySize && ReadBinaryRound(buffer, size, players,
+        round_num, table, deck, next_player);
+  }
+
+  in_file.clear();
+  in_file.seekg(0);
+  round_num = GetRoundNumFromFile(in_file);
+
+  for (unsigned i = 0; i < players.size(); i++) {
+    players[i]->SetScore(GetPlayerScoreFromFile(in_file));
+    players[i]->SetHand(GetCardsFromFile(in_file));
+    players[i]->SetPile(GetCardsFromFile(in_file));
+  }
+
+  table = std::shared_ptr<Table>(new Table);
+  table->SetLooseCards(GetLooseCardsFromFile(in_file));
+  table->SetCurrentBuilds(GetBuildsFromFile(in_file));
+  deck = GetDeckFromFile(in_file);
+  next_player = GetNextPlayerFromFile(in_file);
+  in_file.close();
+
+  return true;
+}
+
+/**
+ * Description: Loads a saved round in either format. Exits on an unreadable
+ *     file.
+ * Parameters: const std::string& file_name: The file name to read from.
+ * std::vector<std::shared_ptr<Player>>& players: The players to fill in.
+ * unsigned& round_num: An input parameter set to the round number.
+ * std::shared_ptr<Table>& table: An input parameter set to the table.
+ * std::shared_ptr<Deck>& deck: An input parameter set to the deck.
+ * unsigned& next_player: An input parameter set to the next player's index.
+ * Returns: Nothing.
+ */
+
+void Serializer::LoadRoundState(
+    const std::string& file_name,
+    std::vector<std::shared_ptr<Player>>& players, unsigned& round_num,
+    std::shared_ptr<Table>& table, std::shared_ptr<Deck>& deck,
+    unsigned& next_player) {
+  if (!ReadRoundState(file_name, players, round_num, table, deck,
+      next_player)) {
+    GUI::DisplayInvalidFileMessage();
+    exit(0);
+  }
+}
+
+/**
+ * Description: Converts a save file to the format its new name asks for.
+ * Parameters: const std::string& in_name: The file to read, in either format.
+ * const std::string& out_name: The file to write; binary if it ends in .bin.
+ * Returns: Whether the file was read and the converted one written.
+ */
+
+bool Serializer::ConvertSaveFile(
+    const std::string& in_name, const std::string& out_name) {
+  std::vector<std::shared_ptr<Player>> players;
+
+  for (unsigned i = 0; i < 2; i++) {
+    players.push_back(std::shared_ptr<Player>(new Computer));
+    players[i]->SetNumber(i);
+    players[i]->SetIsHuman(i == 1);
+  }
+
+  unsigned round_num;
+  unsigned next_player;
+  std::shared_ptr<Table> table;
+  std::shared_ptr<Deck> deck;
+  if (!ReadRoundState(in_name, players, round_num, table, deck,
+      next_player)) {
+    return false;
+  }
+
+  Round round(players, table, deck, next_player, round_num);
+
+  return SaveRoundState(out_name, &round);
+}
+
+/**
+ * Description: Writes a round in the binary format.
+ * Parameters: const unsigned& round_num: The round number.
+ * const std::vector<std::shared_ptr<Player>>& players: The two players.
+ * const std::shared_ptr<Table>& table: The table.
+ * const Deck& deck: The deck.
+ * const unsigned& next_player: The index of the player to move.
+ * uint8_t* buffer: The buffer to write to, at least kMaxBinarySize bytes.
+ * Returns: The number of bytes written.
+ */
+
+unsigned Serializer::WriteBinaryRound(
+    const unsigned& round_num,
+    const std::vector<std::shared_ptr<Player>>& players,
+    const std::shared_ptr<Table>& table, const Deck& deck,
+    const unsigned& next_player, uint8_t* buffer) {
+  uint8_t* out = buffer;
+  *out++ = kBinaryMagic[0];
+  *out++ = kBinaryMagic[1];
+  *out++ = kBinaryVersion;
+  *out++ = round_num & 0xff;
+  *out++ = (round_num >> 8) & 0xff;
+
+  for (unsigned i = 0; i < 2; i++) {
+    *out++ = players[i]->GetScore() & 0xff;
+    *out++ = (players[i]->GetScore() >> 8) & 0xff;
+  }
+
+  *out++ = (next_player & 1) | (table->GetLastCapturedIndex() & 1) << 1;
+  unsigned bit = 0;
+
+  for (unsigned i = 0; i < 2; i++) {
+    WriteBits(players[i]->GetHand().size(), kFieldBits, out, bit);
+    WriteBits(players[i]->GetPile().size(), kFieldBits, out, bit);
+  }
+
+  WriteBits(table->GetNumLooseCards(), kFieldBits, out, bit);
+  WriteBits(deck.GetDeckSize(), kFieldBits, out, bit);
+  WriteBits(table->GetNumBuilds(), kFieldBits, out, bit);
+
+  for (unsigned i = 0; i < 2; i++) {
+    WriteCards(players[i]->GetHand(), out, bit);
+    WriteCards(players[i]->GetPile(), out, bit);
+  }
+
+  WriteCards(table->GetLooseCards(), out, bit);
+  WriteCards(deck.GetCards(), out, bit);
+
+  for (unsigned i = 0; i < table->GetNumBuilds(); i++) {
+    const std::shared_ptr<Build>& build = table->GetBuild(i);
+    WriteBits(build->GetOwnerIndex() & 1, 1, out, bit);
+    WriteBits(build->GetBuildSize(), kFieldBits, out, bit);
+
+    for (unsigned j = 0; j < build->GetBuildSize(); j++) {
+      Build::CardView cards = build->GetBuildAt(j);
+      WriteBits(cards.size(), kFieldBits, out, bit);
+      WriteCards(cards.data(), cards.size(), out, bit);
+    }
+  }
+
+  return out - buffer + (bit + 7) / 8;
+}
+
+/**
+ * Description: Reads a round written by WriteBinaryRound. Nothing is changed
+ *     unless the whole round is valid: every card id in range and used once,
+ *     every build of at least two cards, and every length within the buffer.
+ * Parameters: const uint8_t* buffer: The saved round.
+ * const unsigned& size: The size of the saved round in bytes.
+ * std::vector<std::shared_ptr<Player>>& players: The players to fill in.
+ * unsigned& round_num: An input parameter set to the round number.
+ * std::shared_ptr<Table>& table: An input parameter set to the table.
+ * std::shared_ptr<Deck>& deck: An input parameter set to the deck.
+ * unsigned& next_player: An input parameter set to the next player's index.
+ * Returns: Whether the round was valid.
+ */
+
+bool Serializer::ReadBinaryRound(
+    const uint8_t* buffer, const unsigned& size,
+    std::vector<std::shared_ptr<Player>>& players, unsigned& round_num,
+    std::shared_ptr<Table>& table, std::shared_ptr<Deck>& deck,
+    unsigned& next_player) {
+  if (size < kHeaderSize || buffer[0] != kBinaryMagic[0] ||
+      buffer[1] != kBinaryMagic[1] || buffer[2] != kBinaryVersion) {
+    return false;
+  }
+
+  const uint8_t* in = buffer + kHeaderSize;
+  unsigned end_bit = (size - kHeaderSize) * 8;
+  unsigned bit = 0;
+  unsigned lengths[kNumZones + 1];
+  uint64_t seen = 0;
+  std::vector<Card> zones[kNumZones];
+
+  for (unsigned i = 0; i <= kNumZones; i++) {
+    if (!ReadBits(in, end_bit, kFieldBits, bit, lengths[i])) {
+      return false;
+    }
+  }
+
+  for (unsigned i = 0; i < kNumZones; i++) {
+    if (!ReadCards(in, end_bit, lengths[i], bit, seen, zones[i])) {
+      return false;
+    }
+  }
+
+  std::vector<std::shared_ptr<Build>> builds;
+
+  for (unsigned i = 0; i < lengths[kNumZones]; i++) {
+    unsigned owner_index;
+    unsigned num_sets;
+
+    if (!ReadBits(in, end_bit, 1, bit, owner_index) ||
+        !ReadBits(in, end_bit, kFieldBits, bit, num_sets) || !num_sets) {
+      return false;
+    }
+
+    std::shared_ptr<Build> build(new Build);
+    build->SetOwnerIndex(owner_index);
+    unsigned build_size = 0;
+
+    for (unsigned j = 0; j < num_sets; j++) {
+      std::vector<Card> cards;
+      unsigned build_sum = 0;
+      unsigned num_cards;
+
+      if (!ReadBits(in, end_bit, kFieldBits, bit, num_cards) || !num_cards ||
+          !ReadCards(in, end_bit, num_cards, bit, seen, cards)) {
+        return false;
+      }
+
+      for (unsigned k = 0; k < cards.size(); k++) {
+        build_sum += cards[k].GetValue();
+      }
+
+      build->AddToBuild(cards);
+      build->SetBuildSum(build_sum);
+      build_size += cards.size();
+    }
+
+    if (build_size < 2) {
+      return false;
+    }
+
+    builds.push_back(build);
+  }
+
+  // Only the padding of the last byte may be left, and it must be clear
+  if (end_bit - bit >= 8 || (bit < end_bit && in[bit / 8] >> (bit % 8))) {
+    return false;
+  }
+
+  round_num = buffer[3] | buffer[4] << 8;
+
+  for (unsigned i = 0; i < 2; i++) {
+    players[i]->SetScore(buffer[5 + 2 * i] | buffer[6 + 2 * i] << 8);
+    players[i]->SetHand(zones[2 * i]);
+    players[i]->SetPile(zones[2 * i + 1]);
+  }
+
+  table = std::shared_ptr<Table>(new Table);
+  table->SetLooseCards(zones[4]);
+  table->SetCurrentBuilds(builds);
+  table->SetLastCapturedIndex((buffer[9] >> 1) & 1);
+  deck = std::shared_ptr<Deck>(new Deck(zones[5]));
+  next_player = buffer[9] & 1;
+
+  return true;
+}
+
+/**
+ * Description: Checks if a file name asks for the binary format.
+ * Parameters: const std::string& file_name: The file name.
+ * Returns: Whether it ends in .bin.
+ */
+
+bool Serializer::HasBinaryExtension(const std::string& file_name) {
+  std::string extension = kBinaryExtension;
+
+  return file_name.size() > extension.size() &&
+      !file_name.compare(file_name.size() - extension.size(),
+          extension.size(), extension);
+}
+
+/**
+ * Description: Writes a field, low bit first.
+ * Parameters: const unsigned& value: The value, which must fit in the field.
+ * const unsigned& num_bits: The width of the field.
+ * uint8_t* out: The start of the fields.
+ * unsigned& bit: The write position in bits, moved past the field.
+ * Returns: Nothing.
+ */
+
+void Serializer::WriteBits(const unsigned& value, const unsigned& num_bits,
+    uint8_t* out, unsigned& bit) {
+  for (unsigned i = 0; i < num_bits; i++, bit++) {
+    if (!(bit % 8)) {
+      out[bit / 8] = 0;
+    }
+
+    out[bit / 8] |= ((value >> i) & 1) << (bit % 8);
+  }
+}
+
+/**
+ * Description: Reads a field written by WriteBits.
+ * Parameters: const uint8_t* in: The start of the fields.
+ * const unsigned& end_bit: The number of bits there are to read.
+ * const unsigned& num_bits: The width of the field.
+ * unsigned& bit: The read position in bits, moved past the field.
+ * unsigned& value: An input parameter set to the value.
+ * Returns: Whether the whole field was there.
+ */
+
+bool Serializer::ReadBits(const uint8_t* in, const unsigned& end_bit,
+    const unsigned& num_bits, unsigned& bit, unsigned& value) {
+  if (end_bit - bit < num_bits) {
+    return false;
+  }
+
+  value = 0;
+
+  for (unsigned i = 0; i < num_bits; i++, bit++) {
+    value |= ((in[bit / 8] >> (bit % 8)) & 1) << i;
+  }
+
+  return true;
+}
+
+/**
+ * Description: Writes card ids, one field each.
+ * Parameters: const Card* cards: The cards.
+ * const unsigned& num_cards: The number of cards.
+ * uint8_t* out: The start of the fields.
+ * unsigned& bit: The write position in bits, moved past the cards.
+ * Returns: Nothing.
+ */
+
+void Serializer::WriteCards(const Card* cards, const unsigned& num_cards,
+    uint8_t* out, unsigned& bit) {
+  for (unsigned i = 0; i < num_cards; i++) {
+    WriteBits(cards[i].GetId(), kFieldBits, out, bit);
+  }
+}
+
+/**
+ * Description: Reads card ids written by WriteCards.
+ * Parameters: const uint8_t* in: The start of the fields.
+ * const unsigned& end_bit: The number of bits there are to read.
+ * const unsigned& num_cards: The number of cards to read.
+ * unsigned& bit: The read position in bits, moved past the cards.
+ * uint64_t& seen: The cards read so far, to reject one used twice.
+ * std::vector<Card>& cards: An input parameter to add the cards to.
+ * Returns: Whether the cards were valid.
+ */
+
+bool Serializer::ReadCards(const uint8_t* in, const unsigned& end_bit,
+    const unsigned& num_cards, unsigned& bit, uint64_t& seen,
+    std::vector<Card>& cards) {
+  for (unsigned i = 0; i < num_cards; i++) {
+    unsigned id;
+
+    if (!ReadBits(in, end_bit, kFieldBits, bit, id) ||
+        id >= Card::kNumCards || (seen & (1ULL << id))) {
+      return false;
+    }
+
+    seen |= 1ULL << id;
+    cards.push_back(Card::FromId(id));
+  }
+
+  return true;
 }
\ No newline at end of file
@@ -8,28 +8,47 @@
 #ifndef _SERIALIZER_H_
 #define _SERIALIZER_H_
 
+#include <cstdint>
 #include <string>
 #include <fstream>
 #include "round.h"
 
 class Round;
 
+// Reads and writes saved rounds. Humans get the text format; checkpoints
+// use a binary one that holds the same round in at most kMaxBinarySize bytes:
+//
+//   "CS" version:1 round:2 scores:2x2 flags:1, then 6 bit fields:
+//   the lengths of hand 0, pile 0, hand 1, pile 1, loose cards and deck and
+//   the number of builds, then one card id per card in that order
+//   build: owner (1 bit), number of sets, then per set its length and ids
+//
+// Numbers are little endian and fields are packed from the low bit of each
+// byte up; flag bit 0 is the next player and bit 1 the last player to
+// capture. The bound is the 10 header bytes, 7 counts and 52 card ids, plus
+// 7 bits per build and a length per set: every build holds at least two
+// cards and every set at least one, so there are at most 26 builds and 52
+// sets, 848 bits in all.
 class Serializer {
  public:
+  // Public constants
+  static const unsigned kMaxBinarySize = 116;
+  static const uint8_t kBinaryVersion = 2;
+
   // Public utils
   static inline unsigned GetIntFromString(const std::string& int_as_string) {
     return std::stoi(int_as_string);
   }
 
-  static void SaveRoundState(const std::string& file_name, Round* round);
+  static bool SaveRoundState(const std::string& file_name, Round* round);
   static std::vector<std::string> GetDeckFromFile(const std::string& file_name);
   static std::ifstream OpenLoadFile(const std::string& file_name);
   static unsigned GetRoundNumFromFile(std::ifstream& in_file);
   static unsigned GetPlayerScoreFromFile(std::ifstream& file);
-  static std::vector<std::shared_ptr<Card>> GetCardsFromFile(
+  static std::vector<Card> GetCardsFromFile(
       std::ifstream& in_file);
 
-  static std::vector<std::shared_ptr<Card>> GetLooseCardsFromFile(
+  static std::vector<Card> GetLooseCardsFromFile(
       std::ifstream& in_file);
 
   static std::vector<std::shared_ptr<Build>> GetBuildsFromFile(
@@ -37,6 +56,66 @@ class Serializer {
       
   static std::shared_ptr<Deck> GetDeckFromFile(std::ifstream& in_file);
   static unsigned GetNextPlayerFromFile(std::ifstream& in_file);
+  static bool ReadRoundState(const std::string& file_name,
+      std::vector<std::shared_ptr<Player>>& players, unsigned& round_num,
+      std::shared_ptr<Table>& table, std::shared_ptr<Deck>& deck,
+      unsigned& next_player);
+
+  static void LoadRoundState(const std::string& file_name,
+      std::vector<std::shared_ptr<Player>>& players, unsigned& round_num,
+      std::shared_ptr<Table>& table, std::shared_ptr<Deck>& deck,
+      unsigned& next_player);
+
+  static bool ConvertSaveFile(const std::string& in_name,
+      const std::string& out_name);
+
+  static unsigned WriteBinaryRound(const unsigned& round_num,
+      const std::vector<std::shared_ptr<Player>>& players,
+      const std::shared_ptr<Table>& table, const Deck& deck,
+      const unsigned& next_player, uint8_t* buffer);
+
+  static bool ReadBinaryRound(const uint8_t* buffer, const unsigned& size,
+      std::vector<std::shared_ptr<Player>>& players, unsigned& round_num,
+      std::shared_ptr<Table>& table, std::shared_ptr<Deck>& deck,
+      unsigned& next_player);
+
+ private:
+  // Private constants
+  static const char kBinaryMagic[];
+  static const char kBinaryExtension[];
+  static const unsigned kNumZones = 6;
+  static const unsigned kHeaderSize = 10;
+  static const unsigned kFieldBits = 6;
+  static const unsigned kMaxBuilds = Card::kNumCards / 2;
+
+  static_assert(Card::kNumCards <= 1 << kFieldBits,
+      "Every card id and count must fit in a field");
+  static_assert(kMaxBinarySize == kHeaderSize +
+      ((kNumZones + 1 + 2 * Card::kNumCards + kMaxBuilds) * kFieldBits +
+          kMaxBuilds + 7) / 8,
+      "kMaxBinarySize must be the bound derived above");
+  static_assert(kMaxBinarySize < 128,
+      "A saved round must stay under 128 bytes");
+
+  // Private utils
+  static bool HasBinaryExtension(const std::string& file_name);
+  static void WriteBits(const unsigned& value, const unsigned& num_bits,
+      uint8_t* out, unsigned& bit);
+
+  static bool ReadBits(const uint8_t* in, const unsigned& end_bit,
+      const unsigned& num_bits, unsigned& bit, unsigned& value);
+
+  static inline void WriteCards(
+      const std::vector<Card>& cards, uint8_t* out, unsigned& bit) {
+    WriteCards(cards.data(), cards.size(), out, bit);
+  }
+
+  static void WriteCards(const Card* cards, const unsigned& num_cards,
+      uint8_t* out, unsigned& bit);
+
+  static bool ReadCards(const uint8_t* in, const unsigned& end_bit,
+      const unsigned& num_cards, unsigned& bit, uint64_t& seen,
+      std::vector<Card>& cards);
 };
 
 #endif
\ No newline at end of file
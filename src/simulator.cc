@@ -0,0 +1,230 @@
+#include <chrono>
+#include <cstdlib>
+#include <sstream>
+#include "simulator.h"
+#include "computer.h"
+#include "tournament.h"
+
+/**
+ * Description: Constructs a Computer vs Computer simulator.
+ * Parameters: None.
+ * Returns: Nothing.
+ */
+
+Simulator::Simulator() : Simulator(
+    [] { return std::shared_ptr<Player>(new Computer); },
+    [] { return std::shared_ptr<Player>(new Computer); }) {}
+
+/**
+ * Description: Constructs a simulator between two policies. A policy is any
+ *     player that can move without input.
+ * Parameters: const PlayerFactory& first: Creates the first player.
+ * const PlayerFactory& second: Creates the second player.
+ * Returns: Nothing.
+ */
+
+Simulator::Simulator(const PlayerFactory& first, const PlayerFactory& second) {
+  factories_[0] = first;
+  factories_[1] = second;
+  ResetStats();
+}
+
+/**
+ * Description: Plays one full tournament with no input or output. With a move
+ *     log, its moves are logged under the seed as the game id.
+ * Parameters: const uint64_t& seed: The seed of the game. The same seed always
+ *     plays the same game.
+ * Returns: The final scores and the length of the game.
+ */
+
+Simulator::GameResult Simulator::PlayGame(const uint64_t& seed) {
+  std::vector<std::shared_ptr<Player>> players;
+
+  for (unsigned i = 0; i < 2; i++) {
+    players.push_back(factories_[i]());
+    players[i]->SetIsHuman(false);
+    players[i]->SetIsVerbose(false);
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  Tournament tournament(players, seed);
+  tournament.SetMoveLog(move_log_, seed);
+  GameResult result;
+  result.num_moves = tournament.PlayHeadless(move_latency_);
+  result.num_rounds = tournament.GetNumRounds();
+
+  for (unsigned i = 0; i < 2; i++) {
+    result.scores[i] = players[i]->GetScore();
+  }
+
+  auto end = std::chrono::steady_clock::now();
+  elapsed_nanos_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
+      end - start).count();
+  RecordResult(result);
+
+  return result;
+}
+
+/**
+ * Description: Plays a batch of tournaments back to back.
+ * Parameters: const unsigned& num_games: The number of games to play.
+ * const uint64_t& seed: The seed of the batch. Game i is seeded with
+ *     Random::GetGameSeed(seed, i).
+ * Returns: Nothing.
+ */
+
+void Simulator::PlayGames(const unsigned& num_games, const uint64_t& seed) {
+  for (unsigned i = 0; i < num_games; i++) {
+    PlayGame(Random::GetGameSeed(seed, i));
+  }
+}
+
+/**
+ * Description: Adds the statistics of another simulator to this one.
+ * Parameters: const Simulator& other: The simulator to merge in.
+ * Returns: Nothing.
+ */
+
+void Simulator::Merge(const Simulator& other) {
+  num_games_ += other.num_games_;
+  num_rounds_ += other.num_rounds_;
+  num_moves_ += other.num_moves_;
+  num_ties_ += other.num_ties_;
+  elapsed_nanos_ += other.elapsed_nanos_;
+  move_latency_.Merge(other.move_latency_);
+
+  for (unsigned i = 0; i < 2; i++) {
+    num_wins_[i] += other.num_wins_[i];
+  }
+}
+
+/**
+ * Description: Clears all the statistics.
+ * Parameters: None.
+ * Returns: Nothing.
+ */
+
+void Simulator::ResetStats() {
+  num_games_ = 0;
+  num_rounds_ = 0;
+  num_moves_ = 0;
+  num_wins_[0] = 0;
+  num_wins_[1] = 0;
+  num_ties_ = 0;
+  elapsed_nanos_ = 0;
+  move_latency_.Clear();
+}
+
+/**
+ * Description: Summarizes the statistics as a string.
+ * Parameters: None.
+ * Returns: The summary string.
+ */
+
+std::string Simulator::ToString() const {
+  std::ostringstream summary;
+  summary << "Games: " << num_games_ << '\n'
+          << "Rounds: " << num_rounds_ << '\n'
+          << "Moves: " << num_moves_ << '\n'
+          << "Player 1 wins: " << num_wins_[0] << '\n'
+          << "Player 2 wins: " << num_wins_[1] << '\n'
+          << "Ties: " << num_ties_ << '\n'
+          << "Games/sec: " << GetGamesPerSecond() << '\n'
+          << "Move latency: " << move_latency_.ToString() << '\n';
+
+  return summary.str();
+}
+
+/**
+ * Description: Makes a player factory from a command line spec. The spec is
+ *     "greedy[:<threads>]", "search:<millis>[:<threads>]" for a time budget
+ *     per move, or "playouts:<iterations>[:<threads>]" for an iteration
+ *     budget per move. The greedy players of every game share one pool of
+ *     search threads.
+ * Parameters: const std::string& spec: The spec.
+ * const std::shared_ptr<TranspositionTable>& transpositions: The table the
+ *     searching players share for solved endgames, or null for none.
+ * PlayerFactory& factory: An input parameter set to the factory.
+ * Returns: Whether the spec was valid.
+ */
+
+bool Simulator::ParsePlayerFactory(
+    const std::string& spec,
+    const std::shared_ptr<TranspositionTable>& transpositions,
+    PlayerFactory& factory) {
+  std::string kind = spec.substr(0, spec.find(':'));
+
+  if (kind == "greedy") {
+    unsigned num_threads =
+        (kind == spec ? 1 : atoi(spec.substr(kind.size() + 1).c_str()));
+
+    if (!num_threads) {
+      return false;
+    }
+
+    // One pool for every game, rather than a pool per player per game
+    std::shared_ptr<ThreadPool> search_pool;
+
+    if (num_threads > 1) {
+      search_pool = std::shared_ptr<ThreadPool>(new ThreadPool(num_threads));
+    }
+
+    factory = [search_pool] {
+      std::shared_ptr<Player> computer(new Computer);
+      computer->SetSearchPool(search_pool);
+
+      return computer;
+    };
+
+    return true;
+  }
+
+  if ((kind != "search" && kind != "playouts") || kind == spec) {
+    return false;
+  }
+
+  MonteCarloSearch::Config config = MonteCarloSearch::kDefaultConfig;
+  config.transpositions = transpositions;
+  std::string budget = spec.substr(kind.size() + 1);
+  size_t colon = budget.find(':');
+  unsigned amount = atoi(budget.substr(0, colon).c_str());
+
+  if (colon != std::string::npos) {
+    config.num_threads = atoi(budget.substr(colon + 1).c_str());
+  }
+
+  if (kind == "search") {
+    config.millis = amount;
+  } else {
+    config.millis = 0;
+    config.iterations = amount;
+  }
+
+  if (!amount || !config.num_threads) {
+    return false;
+  }
+
+  factory = [config] {
+    return std::shared_ptr<Player>(new Computer(Computer::kSearch, config));
+  };
+
+  return true;
+}
+
+/**
+ * Description: Adds a finished game to the statistics.
+ * Parameters: const GameResult& result: The finished game.
+ * Returns: Nothing.
+ */
+
+void Simulator::RecordResult(const GameResult& result) {
+  num_games_++;
+  num_rounds_ += result.num_rounds;
+  num_moves_ += result.num_moves;
+
+  if (result.scores[0] == result.scores[1]) {
+    num_ties_++;
+  } else {
+    num_wins_[result.scores[0] > result.scores[1] ? 0 : 1]++;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#ifndef _SIMULATOR_H_
+#define _SIMULATOR_H_
+
+#include <functional>
+#include "player.h"
+#include "latencyhistogram.h"
+#include "random.h"
+#include "transpositiontable.h"
+#include "movelog.h"
+
+class Simulator {
+ public:
+  using PlayerFactory = std::function<std::shared_ptr<Player>()>;
+
+  // Public structs
+  struct GameResult {
+    unsigned scores[2];
+    unsigned num_rounds;
+    unsigned num_moves;
+  };
+
+  // Delete copy constructor and assignment operator
+  Simulator(const Simulator& simulator) = delete;
+  Simulator& operator=(const Simulator& simulator) = delete;
+
+  // Constructors
+  Simulator();
+  Simulator(const PlayerFactory& first, const PlayerFactory& second);
+
+  // Accessors
+  inline unsigned long GetNumGames() const { return num_games_; }
+  inline unsigned long GetNumRounds() const { return num_rounds_; }
+  inline unsigned long GetNumMoves() const { return num_moves_; }
+  inline unsigned long GetNumWins(const unsigned& index) const {
+    return num_wins_[index];
+  }
+
+  inline unsigned long GetNumTies() const { return num_ties_; }
+  inline const LatencyHistogram& GetMoveLatency() const {
+    return move_latency_;
+  }
+
+  inline double GetElapsedSeconds() const { return elapsed_nanos_ / 1e9; }
+  inline double GetGamesPerSecond() const {
+    return elapsed_nanos_ ? num_games_ / GetElapsedSeconds() : 0.0;
+  }
+
+  // Mutators
+  inline void SetMoveLog(const std::shared_ptr<MoveLog>& move_log) {
+    move_log_ = move_log;
+  }
+
+  // Public utils
+  GameResult PlayGame(const uint64_t& seed);
+  void PlayGames(const unsigned& num_games, const uint64_t& seed);
+  void Merge(const Simulator& other);
+  void ResetStats();
+  std::string ToString() const;
+  static bool ParsePlayerFactory(const std::string& spec,
+      const std::shared_ptr<TranspositionTable>& transpositions,
+      PlayerFactory& factory);
+
+ private:
+  PlayerFactory factories_[2];
+  std::shared_ptr<MoveLog> move_log_;
+  unsigned long num_games_;
+  unsigned long num_rounds_;
+  unsigned long num_moves_;
+  unsigned long num_wins_[2];
+  unsigned long num_ties_;
+  unsigned long elapsed_nanos_;
+  LatencyHistogram move_latency_;
+
+  // Private utils
+  void RecordResult(const GameResult& result);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,326 @@
+#include <algorithm>
+#include "subsetsum.h"
+
+/**
+ * Description: Finds every subset of the cards whose value sum, plus an
+ *     offset, is one of the target sums. Sums are at most kMaxSum, so a
+ *     table of the sums reachable from each suffix of the cards lets the
+ *     search skip every branch that cannot reach a target.
+ * Parameters: const std::vector<Card>& cards: The cards to choose from.
+ * const unsigned& offset: Added to the sum of every subset.
+ * const uint32_t& target_sums: Bit s is set when sum s is wanted.
+ * const unsigned& min_size: The fewest cards a subset may have.
+ * ScratchVector<uint64_t>& subsets: An input parameter to fill out with the
+ *     subsets found, in ascending order.
+ * Returns: Nothing.
+ */
+
+void SubsetSum::FindSubsets(
+    const std::vector<Card>& cards, const unsigned& offset,
+    const uint32_t& target_sums, const unsigned& min_size,
+    ScratchVector<uint64_t>& subsets) {
+  uint32_t reachable[Card::kNumCards + 1];
+  unsigned num_cards = cards.size();
+  reachable[num_cards] = 1;
+
+  for (unsigned i = num_cards; i-- > 0;) {
+    reachable[i] = (reachable[i + 1] |
+        (reachable[i + 1] << cards[i].GetValue())) & kSumMask;
+  }
+
+  subsets.clear();
+
+  if (offset > kMaxSum) {
+    return;
+  }
+
+  Search search = {cards, reachable, target_sums & kSumMask, min_size, subsets};
+  Visit(search, 0, offset, 0, 0);
+  std::sort(subsets.begin(), subsets.end());
+}
+
+/**
+ * Description: Finds the distinct unions of pairwise disjoint sets, including
+ *     the empty union, up to a limit. Unions are built by extending the
+ *     earlier ones with each set in turn, so they come out ordered by the
+ *     positions of the sets used. Cards can often be split into sets in more
+ *     than one way, so a union already found is not added again.
+ * Parameters: const ScratchVector<uint64_t>& sets: The sets to combine.
+ * const unsigned& max_unions: The most unions to find.
+ * ScratchVector<uint64_t>& unions: An input parameter to fill out with the
+ *     unions.
+ * Returns: Whether every union was found.
+ */
+
+bool SubsetSum::FindDisjointUnions(
+    const ScratchVector<uint64_t>& sets, const unsigned& max_unions,
+    ScratchVector<uint64_t>& unions) {
+  static thread_local MaskSet found;
+  found.Reset(max_unions);
+  unions.clear();
+
+  if (!max_unions) {
+    return false;
+  }
+
+  unions.push_back(0);
+  found.Insert(0);
+
+  for (unsigned i = 0; i < sets.size(); i++) {
+    unsigned num_unions = unions.size();
+
+    for (unsigned j = 0; j < num_unions; j++) {
+      if (unions[j] & sets[i]) {
+        continue;
+      }
+
+      if (!found.Insert(unions[j] | sets[i])) {
+        continue;
+      }
+
+      if (unions.size() == max_unions) {
+        return false;
+      }
+
+      unions.push_back(unions[j] | sets[i]);
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Description: Finds the cards that can be split into groups of at least two
+ *     that each add up to a target sum, weighing the most between them, with
+ *     no list of groups or unions of them. Cards of one value and weight
+ *     can stand in for each other, so the search memoizes on how many of
+ *     each kind are left: the first card left either stays out or goes in a
+ *     group with later ones, and each state's best choice is kept, so the
+ *     cards are read back by following the choices. Ties keep cards out.
+ * Parameters: const std::vector<Card>& cards: The cards to choose from.
+ * const uint64_t& excluded: The positions of cards to leave out.
+ * const uint32_t& target_sums: Bit s is set when groups may add up to s.
+ * const unsigned* weights: The weight of the card at each position.
+ * unsigned& weight: An input parameter set to the weight of the cards found.
+ * Returns: The cards found, as a mask of positions.
+ */
+
+uint64_t SubsetSum::FindBestPacking(
+    const std::vector<Card>& cards, const uint64_t& excluded,
+    const uint32_t& target_sums, const unsigned* weights, unsigned& weight) {
+  Arena& arena = Arena::GetThreadArena();
+  Packing packing = {target_sums & kSumMask, 0,
+      ScratchVector<Kind>(ArenaAllocator<Kind>(&arena)),
+      Steps(64, std::hash<uint64_t>(), std::equal_to<uint64_t>(),
+          ArenaAllocator<std::pair<const uint64_t, Step>>(&arena))};
+  weight = 0;
+
+  if (!packing.target_sums) {
+    return 0;
+  }
+
+  packing.max_sum = 31 - __builtin_clz(packing.target_sums);
+
+  for (unsigned i = 0; i < cards.size(); i++) {
+    unsigned value = cards[i].GetValue();
+    unsigned k = 0;
+
+    // A card in a group of two or more is below the group's sum
+    if (value >= packing.max_sum || ((excluded >> i) & 1)) {
+      continue;
+    }
+
+    while (k < packing.kinds.size() && (packing.kinds[k].value != value ||
+        packing.kinds[k].weight != weights[i])) {
+      k++;
+    }
+
+    if (k == packing.kinds.size()) {
+      packing.kinds.push_back(Kind{value, weights[i], 0, 0, 0, 0});
+    }
+
+    packing.kinds[k].size++;
+    packing.kinds[k].positions |= 1ULL << i;
+  }
+
+  // High cards first, since they fit in the fewest groups
+  std::sort(packing.kinds.begin(), packing.kinds.end(),
+      [](const Kind& a, const Kind& b) {
+    return a.value != b.value ? a.value > b.value : a.weight > b.weight;
+  });
+
+  uint64_t radix = 1;
+  uint64_t state = 0;
+
+  for (Kind& kind : packing.kinds) {
+    kind.count = kind.size;
+    kind.radix = radix;
+    state += kind.size * radix;
+    radix *= kind.size + 1;
+  }
+
+  weight = Pack(packing, state);
+  uint64_t packed = 0;
+
+  for (auto step = packing.steps.find(state); step != packing.steps.end();
+       step = packing.steps.find(state)) {
+    for (Kind& kind : packing.kinds) {
+      unsigned num_taken = (state / kind.radix) % (kind.size + 1) -
+          (step->second.next / kind.radix) % (kind.size + 1);
+
+      for (unsigned i = 0; i < num_taken; i++) {
+        if (step->second.is_group) {
+          packed |= kind.positions & -kind.positions;
+        }
+
+        kind.positions &= kind.positions - 1;
+      }
+    }
+
+    state = step->second.next;
+  }
+
+  return packed;
+}
+
+/**
+ * Description: Converts a list of positions to a set.
+ * Parameters: const std::vector<unsigned>& indices: The positions.
+ * Returns: The set.
+ */
+
+uint64_t SubsetSum::FromIndices(const std::vector<unsigned>& indices) {
+  uint64_t subset = 0;
+
+  for (unsigned i = 0; i < indices.size(); i++) {
+    subset |= 1ULL << indices[i];
+  }
+
+  return subset;
+}
+
+/**
+ * Description: Converts a set to its positions.
+ * Parameters: const uint64_t& subset: The set.
+ * Returns: The positions in ascending order.
+ */
+
+std::vector<unsigned> SubsetSum::ToIndices(const uint64_t& subset) {
+  std::vector<unsigned> indices;
+
+  for (uint64_t rest = subset; rest; rest &= rest - 1) {
+    indices.push_back(__builtin_ctzll(rest));
+  }
+
+  return indices;
+}
+
+/**
+ * Description: Decides whether cards[index] is in the subset, for every way
+ *     that can still reach a target sum.
+ * Parameters: Search& search: The search state.
+ * const unsigned& index: The position of the card to decide on.
+ * const unsigned& sum: The sum so far, including the offset.
+ * const unsigned& size: The number of cards chosen so far.
+ * const uint64_t& subset: The cards chosen so far.
+ * Returns: Nothing.
+ */
+
+void SubsetSum::Visit(
+    Search& search, const unsigned& index, const unsigned& sum,
+    const unsigned& size, const uint64_t& subset) {
+  if (!((search.target_sums >> sum) & search.reachable[index])) {
+    return;
+  }
+
+  if (index == search.cards.size()) {
+    if (size >= search.min_size) {
+      search.subsets.push_back(subset);
+    }
+
+    return;
+  }
+
+  unsigned value = search.cards[index].GetValue();
+
+  if (sum + value <= kMaxSum) {
+    Visit(search, index + 1, sum + value, size + 1, subset | (1ULL << index));
+  }
+
+  Visit(search, index + 1, sum, size, subset);
+}
+
+/**
+ * Description: Finds the most a packing state can add.
+ * Parameters: Packing& packing: The search state. The kinds' counts must
+ *     match the state, and are as they were on return.
+ * const uint64_t& state: The packing state.
+ * Returns: The most weight its cards can add.
+ */
+
+unsigned SubsetSum::Pack(Packing& packing, const uint64_t& state) {
+  auto found = packing.steps.find(state);
+
+  if (found != packing.steps.end()) {
+    return found->second.weight;
+  }
+
+  unsigned first = 0;
+
+  while (first < packing.kinds.size() && !packing.kinds[first].count) {
+    first++;
+  }
+
+  if (first == packing.kinds.size()) {
+    return 0;
+  }
+
+  Kind& kind = packing.kinds[first];
+  uint64_t next = state - kind.radix;
+  kind.count--;
+  Step step = {Pack(packing, next), next, false};
+  AddGroups(packing, first, next, kind.value, 1, kind.weight, step);
+  kind.count++;
+  packing.steps[state] = step;
+
+  return step.weight;
+}
+
+/**
+ * Description: Tries every group that the cards taken so far can be
+ *     completed to, adding cards of the kinds from first on, and keeps the
+ *     best.
+ * Parameters: Packing& packing: The search state.
+ * const unsigned& first: The first kind that may still be added.
+ * const uint64_t& state: The packing state without the group's cards.
+ * const unsigned& sum: The sum of the group so far.
+ * const unsigned& size: The number of cards in the group so far.
+ * const unsigned& weight: The weight of the group so far.
+ * Step& step: The best step so far, replaced by a better one.
+ * Returns: Nothing.
+ */
+
+void SubsetSum::AddGroups(Packing& packing, const unsigned& first,
+    const uint64_t& state, const unsigned& sum, const unsigned& size,
+    const unsigned& weight, Step& step) {
+  if (size >= 2 && ((packing.target_sums >> sum) & 1)) {
+    unsigned total = weight + Pack(packing, state);
+
+    if (total > step.weight) {
+      step = Step{total, state, true};
+    }
+  }
+
+  for (unsigned k = first; k < packing.kinds.size(); k++) {
+    Kind& kind = packing.kinds[k];
+
+    if (!kind.count || sum + kind.value > packing.max_sum) {
+      continue;
+    }
+
+    kind.count--;
+    AddGroups(packing, k, state - kind.radix, sum + kind.value, size + 1,
+        weight + kind.weight, step);
+    kind.count++;
+  }
+}
\ No newline at end of file
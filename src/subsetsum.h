@@ -0,0 +1,130 @@
+#ifndef _SUBSET_SUM_H_
+#define _SUBSET_SUM_H_
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "arena.h"
+#include "card.h"
+
+// A set of card or position masks, none of which may use the top bit.
+// Open addressing with linear probing, sized once per use.
+class MaskSet {
+ public:
+  // Public utils
+  // Empties the set and makes room for at least max_size masks
+  inline void Reset(const unsigned& max_size) {
+    size_t num_slots = 64;
+
+    while (num_slots < 2 * (size_t) max_size) {
+      num_slots *= 2;
+    }
+
+    slots_.assign(num_slots, 0);
+  }
+
+  // Adds a mask, returning whether it was not in the set yet
+  inline bool Insert(const uint64_t& mask) {
+    uint64_t key = mask | kTaken;
+    size_t last = slots_.size() - 1;
+    size_t slot = (key * 0x9e3779b97f4a7c15ULL) >> 40;
+
+    while (slots_[slot & last] && slots_[slot & last] != key) {
+      slot++;
+    }
+
+    if (slots_[slot & last]) {
+      return false;
+    }
+
+    slots_[slot & last] = key;
+
+    return true;
+  }
+
+ private:
+  // Private constants
+  // Marks a slot taken, so an empty mask can be held too
+  static const uint64_t kTaken = 1ULL << 63;
+
+  ScratchVector<uint64_t> slots_;
+};
+
+// Finds groups of loose cards by the sum of their values. Sets are returned
+// as masks of positions in the given card vector (bit i for cards[i]).
+class SubsetSum {
+ public:
+  // Public constants
+  static const unsigned kMaxSum = Card::kAceTwo;
+
+  // Public utils
+  static inline uint32_t SumToMask(const unsigned& sum) {
+    return sum <= kMaxSum ? 1U << sum : 0;
+  }
+
+  static void FindSubsets(const std::vector<Card>& cards,
+      const unsigned& offset, const uint32_t& target_sums,
+      const unsigned& min_size, ScratchVector<uint64_t>& subsets);
+
+  static bool FindDisjointUnions(const ScratchVector<uint64_t>& sets,
+      const unsigned& max_unions, ScratchVector<uint64_t>& unions);
+
+  static uint64_t FindBestPacking(const std::vector<Card>& cards,
+      const uint64_t& excluded, const uint32_t& target_sums,
+      const unsigned* weights, unsigned& weight);
+
+  static uint64_t FromIndices(const std::vector<unsigned>& indices);
+  static std::vector<unsigned> ToIndices(const uint64_t& subset);
+
+ private:
+  // Private constants
+  static const uint32_t kSumMask = (1U << (kMaxSum + 1)) - 1;
+
+  // Private structs
+  struct Search {
+    const std::vector<Card>& cards;
+    const uint32_t* reachable;
+    uint32_t target_sums;
+    unsigned min_size;
+    ScratchVector<uint64_t>& subsets;
+  };
+
+  // Cards of one value and weight, which a packing can swap for each other.
+  // A packing state is how many of each kind are left, in mixed radix.
+  struct Kind {
+    unsigned value;
+    unsigned weight;
+    unsigned size;
+    unsigned count;
+    uint64_t radix;
+    uint64_t positions;
+  };
+
+  // The most a state can add, and the state that gets it, by leaving a card
+  // out or by taking a group
+  struct Step {
+    unsigned weight;
+    uint64_t next;
+    bool is_group;
+  };
+
+  using Steps = std::unordered_map<uint64_t, Step, std::hash<uint64_t>,
+      std::equal_to<uint64_t>, ArenaAllocator<std::pair<const uint64_t, Step>>>;
+
+  struct Packing {
+    uint32_t target_sums;
+    unsigned max_sum;
+    ScratchVector<Kind> kinds;
+    Steps steps;
+  };
+
+  // Private utils
+  static void Visit(Search& search, const unsigned& index, const unsigned& sum,
+      const unsigned& size, const uint64_t& subset);
+  static unsigned Pack(Packing& packing, const uint64_t& state);
+  static void AddGroups(Packing& packing, const unsigned& first,
+      const uint64_t& state, const unsigned& sum, const unsigned& size,
+      const unsigned& weight, Step& step);
+};
+
+#endif
\ No newline at end of file
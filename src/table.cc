@@ -1,75 +1,20 @@
 #include <algorithm>
-#include <unordered_set>
 #include "table.h"
 #include "inputhandler.h"
 
 /**
  * Description: Add the cards dealt at the beginning of a round.
- * Parameters: const std::vector<std::shared_ptr<Card>>& dealt:
+ * Parameters: const std::vector<Card>& dealt:
  *     The dealt cards.
  * Returns: Nothing.
  */
 
-void Table::AddDealtCards(const std::vector<std::shared_ptr<Card>>& dealt) {
+void Table::AddDealtCards(const std::vector<Card>& dealt) {
   for (unsigned i = 0; i < dealt.size(); i++) {
-    loose_cards_.push_back(dealt[i]);
+    AddLooseCard(dealt[i]);
   }
 }
 
-/**
- * Description: Checks if a value matches a loose card on the table.
- * Parameters: const unsigned& card_value: The card value.
- * Returns: Whether or not there was a match.
- */
-
-bool Table::ValueMatchesLooseCard(const unsigned& card_value) const {
-  for (unsigned i = 0; i < loose_cards_.size(); i++) {
-    if (card_value == loose_cards_[i]->GetValue()) {
-      return true;
-    }
-  }
-
-  return false;
-}
-
-/**
- * Description: Checks if a value matches a build on the table.
- * Parameters: const unsigned& card_value: The card value.
- * const unsigned& player_number: The player number.
- * Returns: Whether or not there was a match.
- */
-
-bool Table::ValueMatchesBuild(
-    const unsigned& card_value, const unsigned& player_number) const {
-  for (unsigned i = 0; i < current_builds_.size(); i++) {
-    if (current_builds_[i]->GetOwnerIndex() != player_number) {
-      continue;
-    }
-
-    if (current_builds_[i]->GetBuildSum() == card_value) {
-      return true;
-    }
-  }
-
-  return false;
-}
-
-/**
- * Description: Checks if a player owns any builds.
- * Parameters: const unsigned& player_number: The current player number.
- * Returns: Whether or not there was a match.
- */
-
-bool Table::PlayerOwnsAnyBuilds(const unsigned& player_number) const {
-  for (unsigned i = 0; i < current_builds_.size(); i++) {
-    if (current_builds_[i]->GetOwnerIndex() == player_number) {
-      return true;
-    }
-  }
-
-  return false;
-}
-
 /**
  * Description: Checks the given set of cards is on the table.
  * Parameters: const std::vector<std::string>& cards: The serialized cards.
@@ -81,10 +26,18 @@ bool Table::PlayerOwnsAnyBuilds(const unsigned& player_number) const {
 bool Table::CardsOnTable(
     const std::vector<std::string>& cards,
     std::vector<unsigned>& card_indices) const {
-  for (unsigned i = 0; i < loose_cards_.size(); i++) {
-    auto card = loose_cards_[i];
+  uint64_t mask = Bitboard::kEmpty;
+
+  for (unsigned i = 0; i < cards.size(); i++) {
+    mask |= Bitboard::FromCard(Card(cards[i]));
+  }
 
-    if (find(cards.begin(), cards.end(), card->ToString()) != cards.end()) {
+  if ((mask & loose_mask_) != mask) {
+    return false;
+  }
+
+  for (unsigned i = 0; i < loose_cards_.size(); i++) {
+    if (Bitboard::Contains(mask, loose_cards_[i])) {
       card_indices.push_back(i);
     }
   }
@@ -102,30 +55,14 @@ bool Table::CardsOnTable(
 
 bool Table::CardsInBuild(
     const std::vector<std::string>& cards, unsigned& build_index) const {
-  std::unordered_set<std::string> seen;
+  uint64_t mask = Bitboard::kEmpty;
 
   for (unsigned i = 0; i < cards.size(); i++) {
-    seen.insert(cards[i]);
+    mask |= Bitboard::FromCard(Card(cards[i]));
   }
 
   for (unsigned i = 0; i < current_builds_.size(); i++) {
-    std::unordered_set<std::string> seen_on_table;
-    auto current_build = current_builds_[i];
-
-    for (unsigned j = 0; j < current_build->GetBuildSize(); j++) {
-      for (unsigned k = 0; k < current_build->GetBuildAt(j).size(); k++) {
-        std::string card_str = current_build->GetBuildAt(j)[k]->ToString();
-
-        if (seen.find(card_str) == seen.end()) {
-          seen_on_table.clear();
-          break;
-        }
-
-        seen_on_table.insert(card_str);
-      }
-    }
-
-    if (seen_on_table.size() == seen.size()) {
+    if (current_builds_[i]->GetCardMask() == mask) {
       build_index = i;
       return true;
     }
@@ -135,82 +72,106 @@ bool Table::CardsInBuild(
 }
 
 /**
- * Description: Removes the loose cards at the given indices.
- * Parameters: const std::vector<unsigned>& indices: The indices of loose cards.
+ * Description: Removes the loose cards at the given positions.
+ * Parameters: const uint64_t& positions: Bit i is set to remove the loose card
+ *     at index i.
  * Returns: Nothing.
  */
 
-void Table::RemoveLooseCards(const std::vector<unsigned>& indices) {
-  std::vector<std::shared_ptr<Card>> temp;
+void Table::RemoveLooseCards(const uint64_t& positions) {
+  uint64_t mask = Bitboard::kEmpty;
 
-  for (unsigned i = 0; i < loose_cards_.size(); i++) {
-    if (find(indices.begin(), indices.end(), i) == indices.end()) {
-      temp.push_back(loose_cards_[i]);
-    }
+  for (uint64_t rest = positions; rest; rest &= rest - 1) {
+    mask |= Bitboard::FromCard(loose_cards_[__builtin_ctzll(rest)]);
   }
 
-  loose_cards_.clear();
+  RemoveLooseCardsInMask(mask);
+}
 
-  for (unsigned i = 0; i < temp.size(); i++) {
-    loose_cards_.push_back(temp[i]);
-  }
+/**
+ * Description: Removes the loose cards in the given set, keeping the order of
+ *     the rest.
+ * Parameters: const uint64_t& mask: The cards to remove.
+ * Returns: Nothing.
+ */
+
+void Table::RemoveLooseCardsInMask(const uint64_t& mask) {
+  loose_cards_.erase(std::remove_if(loose_cards_.begin(), loose_cards_.end(),
+      [&mask](const Card& card) { return Bitboard::Contains(mask, card); }),
+      loose_cards_.end());
+  hash_ ^= Zobrist::HashCards(kZobristKeys.loose, loose_mask_ & mask);
+  loose_mask_ &= ~mask;
 }
 
 /**
- * Description: Removes the builds at the given indices.
- * Parameters: const std::vector<unsigned>& indices: The indices of builds.
+ * Description: Removes the builds in the given set, keeping the order of the
+ *     rest.
+ * Parameters: const uint32_t& mask: Bit i is set to remove the build at
+ *     index i.
  * Returns: Nothing.
  */
 
-void Table::RemoveMultipleBuilds(const std::vector<unsigned>& indices) {
-  std::vector<std::shared_ptr<Build>> temp;
+void Table::RemoveBuildsInMask(const uint32_t& mask) {
+  unsigned kept = 0;
 
   for (unsigned i = 0; i < current_builds_.size(); i++) {
-    if (find(indices.begin(), indices.end(), i) == indices.end()) {
-      temp.push_back(current_builds_[i]);
+    if (mask & (1U << i)) {
+      IndexBuild(*current_builds_[i], -1);
+    } else {
+      current_builds_[kept++] = std::move(current_builds_[i]);
     }
   }
 
-  current_builds_.clear();
-
-  for (unsigned i = 0; i < temp.size(); i++) {
-    current_builds_.push_back(temp[i]);
-  }
+  current_builds_.resize(kept);
 }
 
 /**
- * Description: Deconstructs a given build.
- * Parameters: const unsigned& index: The build index.
- * Returns: A vector of the cards that were removed.
+ * Description: Puts removed loose cards back where they were.
+ * Parameters: const uint64_t& positions: Bit i is set when the card at index
+ *     i, once restored, is one of the given cards.
+ * const Card* cards: The cards to put back, in table order.
+ * Returns: Nothing.
  */
 
-std::vector<std::shared_ptr<Card>> Table::DeconstructBuild(
-    const unsigned& index) {
-  std::vector<std::shared_ptr<Card>> cards;
-
-  for (unsigned i = 0; i < current_builds_[index]->GetBuildSize(); i++) {
-    for (auto card : current_builds_[index]->GetBuildAt(i)) {
-      cards.push_back(card);
+void Table::InsertLooseCards(const uint64_t& positions, const Card* cards) {
+  unsigned num_cards = Bitboard::Count(positions);
+  unsigned from = loose_cards_.size();
+  loose_cards_.resize(from + num_cards);
+
+  for (unsigned i = loose_cards_.size(); i-- > 0;) {
+    if (positions & (1ULL << i)) {
+      loose_cards_[i] = cards[--num_cards];
+      loose_mask_ |= Bitboard::FromCard(loose_cards_[i]);
+      hash_ ^= kZobristKeys.loose[loose_cards_[i].GetId()];
+    } else {
+      loose_cards_[i] = loose_cards_[--from];
     }
   }
-
-  return cards;
 }
 
 /**
- * Description: Checks whether or not the table has aces.
- * Parameters: None.
- * Returns: Whether or not the table has aces.
+ * Description: Puts removed builds back where they were.
+ * Parameters: const uint32_t& positions: Bit i is set when the build at index
+ *     i, once restored, is one of the given builds.
+ * const std::shared_ptr<Build>* builds: The builds to put back, in table
+ *     order.
+ * Returns: Nothing.
  */
 
-bool Table::HasAces() const {
-  for (unsigned i = 0; i < loose_cards_.size(); i++) {
-    if (loose_cards_[i]->IsAce()) {
-      return true;
+void Table::InsertBuilds(
+    const uint32_t& positions, const std::shared_ptr<Build>* builds) {
+  unsigned num_builds = __builtin_popcount(positions);
+  unsigned from = current_builds_.size();
+  current_builds_.resize(from + num_builds);
+
+  for (unsigned i = current_builds_.size(); i-- > 0;) {
+    if (positions & (1U << i)) {
+      current_builds_[i] = builds[--num_builds];
+      IndexBuild(*current_builds_[i], 1);
+    } else {
+      current_builds_[i] = std::move(current_builds_[--from]);
     }
   }
-
-  return false;
 }
 
 /**
@@ -219,18 +180,39 @@ bool Table::HasAces() const {
  * Returns: A vector of cards that were cleared.
  */
 
-std::vector<std::shared_ptr<Card>> Table::ClearTable() {
-  std::vector<std::shared_ptr<Card>> cards;
+std::vector<Card> Table::ClearTable() {
+  std::vector<Card> cards;
 
   for (unsigned i = 0; i < loose_cards_.size(); i++) {
     cards.push_back(loose_cards_[i]);
   }
 
   loose_cards_.clear();
+  hash_ ^= Zobrist::HashCards(kZobristKeys.loose, loose_mask_);
+  loose_mask_ = Bitboard::kEmpty;
 
   return cards;
 }
 
+/**
+ * Description: Copies the table and its builds, for a move to be tried out on
+ *     without touching the real one.
+ * Parameters: None.
+ * Returns: The copy.
+ */
+
+std::shared_ptr<Table> Table::Clone() const {
+  std::shared_ptr<Table> table(new Table);
+  table->SetLooseCards(loose_cards_);
+  table->SetLastCapturedIndex(last_captured_index_);
+
+  for (unsigned i = 0; i < current_builds_.size(); i++) {
+    table->AddBuild(current_builds_[i]->Clone());
+  }
+
+  return table;
+}
+
 /**
  * Description: Serializes the table into a string.
  * Parameters: None.
@@ -245,8 +227,24 @@ std::string Table::ToString() const {
   }
 
   for (unsigned i = 0; i < loose_cards_.size(); i++) {
-    table += loose_cards_[i]->ToString() + " ";
+    table += loose_cards_[i].ToString() + " ";
   }
 
   return table;
+}
+
+/**
+ * Description: Empties the index of build sums.
+ * Parameters: None.
+ * Returns: Nothing.
+ */
+
+void Table::ClearBuildIndex() {
+  for (unsigned i = 0; i < 2; i++) {
+    num_owned_builds_[i] = 0;
+
+    for (unsigned j = 0; j < kNumBuildSums; j++) {
+      num_builds_[i][j] = 0;
+    }
+  }
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 #define _TABLE_H_
 
 #include "build.h"
+#include "bitboard.h"
+#include "zobrist.h"
 
 class Table {
  public:
@@ -10,56 +12,116 @@ class Table {
   Table& operator=(const Table& table) = delete;
 
   // Constructors
-  Table() : last_captured_index_(0) {}
+  Table() : loose_mask_(Bitboard::kEmpty), last_captured_index_(0),
+      hash_(kZobristKeys.last_captured[0]) {
+    loose_cards_.reserve(Card::kNumCards);
+    current_builds_.reserve(Card::kNumCards / 2);
+    ClearBuildIndex();
+  }
 
   // Accessors
-  inline std::vector<std::shared_ptr<Card>> GetLooseCards() const {
+  inline const std::vector<Card>& GetLooseCards() const {
     return loose_cards_;
   }
 
-  inline std::vector<std::shared_ptr<Build>> GetCurrentBuilds() const {
+  inline const std::vector<std::shared_ptr<Build>>& GetCurrentBuilds() const {
     return current_builds_;
   }
 
+  inline unsigned GetNumLooseCards() const { return loose_cards_.size(); }
+  inline unsigned GetNumBuilds() const { return current_builds_.size(); }
+  inline const std::shared_ptr<Build>& GetBuild(const unsigned& index) const {
+    return current_builds_[index];
+  }
+
+  inline uint64_t GetLooseMask() const { return loose_mask_; }
   inline unsigned GetLastCapturedIndex() const { return last_captured_index_; }
 
+  // The loose cards, builds and last capturer; builds keep their own hashes
+  inline uint64_t GetHash() const {
+    uint64_t hash = hash_;
+
+    for (unsigned i = 0; i < current_builds_.size(); i++) {
+      hash ^= current_builds_[i]->GetHash();
+    }
+
+    return hash;
+  }
+
   // Mutators
   inline void SetLooseCards(
-      const std::vector<std::shared_ptr<Card>>& loose_cards)  {
+      const std::vector<Card>& loose_cards)  {
+    hash_ ^= Zobrist::HashCards(kZobristKeys.loose, loose_mask_);
     loose_cards_ = loose_cards;
+    loose_mask_ = Bitboard::FromCards(loose_cards);
+    hash_ ^= Zobrist::HashCards(kZobristKeys.loose, loose_mask_);
   }
 
   inline void SetCurrentBuilds(
       const std::vector<std::shared_ptr<Build>>& current_builds)  {
     current_builds_ = current_builds;
+    ClearBuildIndex();
+
+    for (unsigned i = 0; i < current_builds_.size(); i++) {
+      IndexBuild(*current_builds_[i], 1);
+    }
+  }
+
+  // Builds on the table change sum and owner through here, so the index of
+  // build sums stays in step
+  inline void UpdateBuild(const std::shared_ptr<Build>& build,
+      const unsigned& build_sum, const unsigned& owner_index) {
+    IndexBuild(*build, -1);
+    build->SetBuildSum(build_sum);
+    build->SetOwnerIndex(owner_index);
+    IndexBuild(*build, 1);
   }
 
   inline void SetLastCapturedIndex(const unsigned& last_captured_index) {
+    hash_ ^= kZobristKeys.last_captured[last_captured_index_ & 1] ^
+        kZobristKeys.last_captured[last_captured_index & 1];
     last_captured_index_ = last_captured_index;
   }
 
   // Public utils
-  bool ValueMatchesLooseCard(const unsigned& card_value) const;
-  bool ValueMatchesBuild(const unsigned& card_value,
-      const unsigned& player_number) const;
+  inline bool ValueMatchesLooseCard(const unsigned& card_value) const {
+    return card_value >= Card::kAceOne && card_value <= Card::kNumValues &&
+        (loose_mask_ & Bitboard::FromValue(card_value));
+  }
+
+  inline bool ValueMatchesBuild(const unsigned& card_value,
+      const unsigned& player_number) const {
+    return card_value < kNumBuildSums &&
+        num_builds_[player_number & 1][card_value];
+  }
+
+  inline bool ValueMatchesAnyBuild(const unsigned& card_value) const {
+    return ValueMatchesBuild(card_value, 0) ||
+        ValueMatchesBuild(card_value, 1);
+  }
+
+  inline bool PlayerOwnsAnyBuilds(const unsigned& player_number) const {
+    return num_owned_builds_[player_number & 1];
+  }
 
-  bool PlayerOwnsAnyBuilds(const unsigned& player_number) const;
   bool CardsOnTable(const std::vector<std::string>& cards,
       std::vector<unsigned>& card_indices) const;
 
   bool CardsInBuild(const std::vector<std::string>& cards,
       unsigned& build_index) const;
 
-  void AddDealtCards(const std::vector<std::shared_ptr<Card>>& dealt);
-  inline void AddLooseCard(const std::shared_ptr<Card>& card) {
+  void AddDealtCards(const std::vector<Card>& dealt);
+  inline void AddLooseCard(const Card& card) {
     loose_cards_.push_back(card);
+    loose_mask_ |= Bitboard::FromCard(card);
+    hash_ ^= kZobristKeys.loose[card.GetId()];
   }
 
   inline void AddBuild(const std::shared_ptr<Build>& build) {
     current_builds_.push_back(build);
+    IndexBuild(*build, 1);
   }
 
-  std::vector<std::shared_ptr<Card>> DeconstructBuild(const unsigned& index);
   inline unsigned GetTableSize() const {
     return loose_cards_.size() + current_builds_.size();
   }
@@ -68,25 +130,61 @@ class Table {
     return loose_cards_.empty() && current_builds_.empty();
   }
 
-  inline std::shared_ptr<Card> GetLooseCard(const unsigned& index) const {
+  inline Card GetLooseCard(const unsigned& index) const {
     return loose_cards_[index];
   }
 
-  void RemoveLooseCards(const std::vector<unsigned>& indices);
+  void RemoveLooseCards(const uint64_t& positions);
+  void RemoveLooseCardsInMask(const uint64_t& mask);
   inline void RemoveBuild(const unsigned& index) {
+    IndexBuild(*current_builds_[index], -1);
     current_builds_.erase(current_builds_.begin() + index);
   }
 
-  void RemoveMultipleBuilds(const std::vector<unsigned>& indices);
-  bool HasAces() const;
+  void RemoveBuildsInMask(const uint32_t& mask);
+  inline void RemoveLastBuild() {
+    IndexBuild(*current_builds_.back(), -1);
+    current_builds_.pop_back();
+  }
+
+  inline void RemoveLastLooseCard() {
+    loose_mask_ &= ~Bitboard::FromCard(loose_cards_.back());
+    hash_ ^= kZobristKeys.loose[loose_cards_.back().GetId()];
+    loose_cards_.pop_back();
+  }
+
+  void InsertLooseCards(const uint64_t& positions, const Card* cards);
+  void InsertBuilds(const uint32_t& positions,
+      const std::shared_ptr<Build>* builds);
 
-  std::vector<std::shared_ptr<Card>> ClearTable();
+  inline bool HasAces() const { return loose_mask_ & Bitboard::kAces; }
+
+  std::vector<Card> ClearTable();
+  std::shared_ptr<Table> Clone() const;
   std::string ToString() const;
 
  private:
+  // Private constants
+  static const unsigned kNumBuildSums = Card::kAceTwo + 1;
+
   std::vector<std::shared_ptr<Build>> current_builds_;
-  std::vector<std::shared_ptr<Card>> loose_cards_;
+  std::vector<Card> loose_cards_;
+  uint64_t loose_mask_;
   unsigned last_captured_index_;
+  uint64_t hash_;
+
+  // The builds on the table counted by owner and sum, and by owner alone
+  unsigned num_builds_[2][kNumBuildSums];
+  unsigned num_owned_builds_[2];
+
+  // Private utils
+  inline void IndexBuild(const Build& build, const int& count) {
+    unsigned owner = build.GetOwnerIndex() & 1;
+    num_builds_[owner][build.GetBuildSum() % kNumBuildSums] += count;
+    num_owned_builds_[owner] += count;
+  }
+
+  void ClearBuildIndex();
 };
 
 #endif
\ No newline at end of file
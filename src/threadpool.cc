@@ -0,0 +1,172 @@
+#include "threadpool.h"
+
+// The pool and worker index running on this thread, if any
+static thread_local ThreadPool* worker_pool = nullptr;
+static thread_local int worker_index = -1;
+
+/**
+ * Description: Starts the worker threads.
+ * Parameters: const unsigned& num_threads: The number of workers (at least 1).
+ * Returns: Nothing.
+ */
+
+ThreadPool::ThreadPool(const unsigned& num_threads) :
+    num_queued_(0), num_pending_(0), next_worker_(0), stopping_(false) {
+  unsigned count = num_threads ? num_threads : 1;
+
+  for (unsigned i = 0; i < count; i++) {
+    workers_.push_back(std::unique_ptr<Worker>(new Worker));
+  }
+
+  for (unsigned i = 0; i < count; i++) {
+    threads_.push_back(std::thread(&ThreadPool::Run, this, i));
+  }
+}
+
+/**
+ * Description: Finishes the queued work and joins the worker threads.
+ * Parameters: None.
+ * Returns: Nothing.
+ */
+
+ThreadPool::~ThreadPool() {
+  Wait();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+
+  work_available_.notify_all();
+
+  for (unsigned i = 0; i < threads_.size(); i++) {
+    threads_[i].join();
+  }
+}
+
+/**
+ * Description: Queues a task. Tasks submitted from a worker go to that
+ *     worker's own deque, others are spread round robin.
+ * Parameters: const Task& task: The task to run.
+ * Returns: Nothing.
+ */
+
+void ThreadPool::Submit(const Task& task) {
+  unsigned index = 0;
+  num_pending_++;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    index = (worker_pool == this ? worker_index : next_worker_++);
+    index %= workers_.size();
+    num_queued_++;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(workers_[index]->mutex);
+    workers_[index]->tasks.push_back(task);
+  }
+
+  work_available_.notify_one();
+}
+
+/**
+ * Description: Blocks until every submitted task has finished. Must not be
+ *     called from inside a task.
+ * Parameters: None.
+ * Returns: Nothing.
+ */
+
+void ThreadPool::Wait() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  work_done_.wait(lock, [this] { return num_pending_ == 0; });
+}
+
+/**
+ * Description: Gets the index of the worker running the calling thread.
+ * Parameters: None.
+ * Returns: The worker index, or -1 when not called from a worker.
+ */
+
+int ThreadPool::GetWorkerIndex() {
+  return worker_index;
+}
+
+/**
+ * Description: Gets the number of hardware threads.
+ * Parameters: None.
+ * Returns: The number of threads to use by default (at least 1).
+ */
+
+unsigned ThreadPool::GetDefaultNumThreads() {
+  unsigned count = std::thread::hardware_concurrency();
+
+  return count ? count : 1;
+}
+
+/**
+ * Description: The worker loop.
+ * Parameters: const unsigned& index: The index of the worker.
+ * Returns: Nothing.
+ */
+
+void ThreadPool::Run(const unsigned& index) {
+  worker_pool = this;
+  worker_index = index;
+  Task task;
+
+  while (true) {
+    if (PopTask(index, task)) {
+      task();
+      task = nullptr;
+
+      if (--num_pending_ == 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        work_done_.notify_all();
+      }
+
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    work_available_.wait(lock, [this] { return num_queued_ || stopping_; });
+
+    if (stopping_ && !num_queued_) {
+      return;
+    }
+  }
+}
+
+/**
+ * Description: Takes the next task for a worker, stealing if its own deque is
+ *     empty.
+ * Parameters: const unsigned& index: The index of the worker.
+ * Task& task: An input parameter to fill out with the task.
+ * Returns: Whether or not a task was found.
+ */
+
+bool ThreadPool::PopTask(const unsigned& index, Task& task) {
+  for (unsigned i = 0; i < workers_.size(); i++) {
+    unsigned victim = (index + i) % workers_.size();
+    std::lock_guard<std::mutex> lock(workers_[victim]->mutex);
+    auto& tasks = workers_[victim]->tasks;
+
+    if (tasks.empty()) {
+      continue;
+    }
+
+    if (victim == index) {
+      task = tasks.back();
+      tasks.pop_back();
+    } else {
+      task = tasks.front();
+      tasks.pop_front();
+    }
+
+    num_queued_--;
+
+    return true;
+  }
+
+  return false;
+}
\ No newline at end of file
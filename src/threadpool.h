@@ -0,0 +1,57 @@
+#ifndef _THREAD_POOL_H_
+#define _THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+ public:
+  using Task = std::function<void()>;
+
+  // Delete copy constructor and assignment operator
+  ThreadPool(const ThreadPool& thread_pool) = delete;
+  ThreadPool& operator=(const ThreadPool& thread_pool) = delete;
+
+  // Constructors
+  ThreadPool(const unsigned& num_threads);
+  ~ThreadPool();
+
+  // Accessors
+  inline unsigned GetNumThreads() const { return threads_.size(); }
+
+  // Public utils
+  void Submit(const Task& task);
+  void Wait();
+  static int GetWorkerIndex();
+  static unsigned GetDefaultNumThreads();
+
+ private:
+  // Each worker owns a deque. It pops its own work from the back and steals
+  // from the front of the others when it runs dry.
+  struct Worker {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::vector<std::thread> threads_;
+  std::mutex mutex_;
+  std::condition_variable work_available_;
+  std::condition_variable work_done_;
+  std::atomic<unsigned> num_queued_;
+  std::atomic<unsigned> num_pending_;
+  unsigned next_worker_;
+  bool stopping_;
+
+  // Private utils
+  void Run(const unsigned& index);
+  bool PopTask(const unsigned& index, Task& task);
+};
+
+#endif
\ No newline at end of file
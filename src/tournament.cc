@@ -1,3 +1,4 @@
+#include <ctime>
 #include "tournament.h"
 #include "gui.h"
 #include "serializer.h"
@@ -11,7 +12,7 @@
  * Returns: Nothing.
  */
 
-Tournament::Tournament() {
+Tournament::Tournament() : rng_(rand()) {
   players_.push_back(std::shared_ptr<Player>(new Computer));
   players_[0]->SetIsHuman(false);
   players_[0]->SetNumber(0);
@@ -19,6 +20,25 @@ Tournament::Tournament() {
   players_[1]->SetIsHuman(true);
   players_[1]->SetNumber(1);
   round_num_ = 1;
+  game_id_ = time(NULL);
+  ply_ = 0;
+}
+
+/**
+ * Description: Constructs a fresh tournament between the given players. All of
+ *     its randomness (coin toss and shuffles) comes from the seed.
+ * Parameters: const std::vector<std::shared_ptr<Player>>& players: The
+ *     players, numbered by their position.
+ * const uint64_t& seed: The seed for the coin toss and the decks.
+ * Returns: Nothing.
+ */
+
+Tournament::Tournament(
+    const std::vector<std::shared_ptr<Player>>& players, const uint64_t& seed) :
+    round_num_(1), players_(players), rng_(seed), game_id_(seed), ply_(0) {
+  for (unsigned i = 0; i < players_.size(); i++) {
+    players_[i]->SetNumber(i);
+  }
 }
 
 /**
@@ -45,9 +65,8 @@ bool Tournament::TournamentOver() {
 
 void Tournament::PlayGame() {
   while (!TournamentOver()) {
-    rounds_.push_back(
-        std::shared_ptr<Round>(new Round(players_, round_num_++)));
-    rounds_[rounds_.size() - 1]->PlayRound();
+    AddRound(new Round(players_, round_num_++)).PlayRound();
+    ply_ = rounds_[rounds_.size() - 1]->GetPly();
   }
 
   GUI::DisplayWinningState(players_);
@@ -55,19 +74,18 @@ void Tournament::PlayGame() {
 
 /**
  * Description: Plays from a loaded state.
- * Parameters: std::ifstream& in_file: The file to load from.
+ * Parameters: std::shared_ptr<Table>& table: The loaded table.
+ * std::shared_ptr<Deck>& deck: The loaded deck.
+ * const unsigned& next_player: The index of the loaded next player.
  * Returns: Nothing.
  */
 
-void Tournament::PlayLoaded(std::ifstream& in_file) {
-  std::shared_ptr<Table> table(new Table);
-  table->SetLooseCards(Serializer::GetLooseCardsFromFile(in_file));
-  table->SetCurrentBuilds(Serializer::GetBuildsFromFile(in_file));
-  std::shared_ptr<Deck> deck = Serializer::GetDeckFromFile(in_file);
-  unsigned next_player = Serializer::GetNextPlayerFromFile(in_file);
-  rounds_.push_back(std::shared_ptr<Round>(new Round(
-      players_, table, deck, next_player, round_num_++)));
-  rounds_[rounds_.size() - 1]->PlayRound();
+void Tournament::PlayLoaded(
+    std::shared_ptr<Table>& table, std::shared_ptr<Deck>& deck,
+    const unsigned& next_player) {
+  AddRound(new Round(players_, table, deck, next_player, round_num_++))
+      .PlayRound();
+  ply_ = rounds_[rounds_.size() - 1]->GetPly();
 
   PlayGame();
 }
@@ -88,4 +106,46 @@ void Tournament::PlayNew() {
   }
 
   PlayGame();
+}
+
+/**
+ * Description: Plays a new tournament without any input or output. The coin
+ *     toss and every deck come from the tournament's generator.
+ * Parameters: LatencyHistogram& move_latency: Records how long each move took.
+ * Returns: The number of moves made.
+ */
+
+unsigned Tournament::PlayHeadless(LatencyHistogram& move_latency) {
+  unsigned num_moves = 0;
+  unsigned first_player_index = FlipCoin();
+
+  for (unsigned i = 0; i < players_.size(); i++) {
+    players_[i]->SetIsTurn(i == first_player_index);
+  }
+
+  while (!TournamentOver()) {
+    std::shared_ptr<Deck> deck(new Deck(rng_));
+    num_moves += AddRound(new Round(players_, deck, round_num_++))
+        .PlayHeadless(move_latency);
+    ply_ = rounds_[rounds_.size() - 1]->GetPly();
+  }
+
+  return num_moves;
+}
+
+/**
+ * Description: Adds a round, logging its moves after the previous round's if
+ *     the tournament has a move log.
+ * Parameters: Round* round: The new round, owned by the tournament from now.
+ * Returns: The round.
+ */
+
+Round& Tournament::AddRound(Round* round) {
+  rounds_.push_back(std::shared_ptr<Round>(round));
+
+  if (move_log_) {
+    round->SetMoveLog(move_log_, game_id_, ply_);
+  }
+
+  return *round;
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <fstream>
 #include "player.h"
 #include "round.h"
+#include "random.h"
 
 class Tournament {
  public:
@@ -13,18 +14,30 @@ class Tournament {
 
   // Constructors
   Tournament();
+  Tournament(const std::vector<std::shared_ptr<Player>>& players,
+      const uint64_t& seed);
 
   // Accessors
   std::vector<std::shared_ptr<Player>> GetPlayers() const { return players_; }
+  inline unsigned GetNumRounds() const { return rounds_.size(); }
 
   // Mutators
   inline void SetRoundNum(const unsigned& round_num) {
     round_num_ = round_num;
   }
 
+  // Every move of every round is appended to the log under the game id
+  inline void SetMoveLog(const std::shared_ptr<MoveLog>& move_log,
+      const uint64_t& game_id) {
+    move_log_ = move_log;
+    game_id_ = game_id;
+  }
+
   // Public utils
   void PlayNew();
-  void PlayLoaded(std::ifstream& in_file);
+  void PlayLoaded(std::shared_ptr<Table>& table, std::shared_ptr<Deck>& deck,
+      const unsigned& next_player);
+  unsigned PlayHeadless(LatencyHistogram& move_latency);
 
  private:
   // Private constants
@@ -33,11 +46,16 @@ class Tournament {
   unsigned round_num_;
   std::vector<std::shared_ptr<Round>> rounds_;
   std::vector<std::shared_ptr<Player>> players_;
+  Random rng_;
+  std::shared_ptr<MoveLog> move_log_;
+  uint64_t game_id_;
+  unsigned ply_;
   
   // Private utils
   bool TournamentOver();
-  inline unsigned FlipCoin() { return (rand() % 2); }
+  inline unsigned FlipCoin() { return rng_.NextBelow(2); }
   void PlayGame();
+  Round& AddRound(Round* round);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include <sstream>
+#include "transpositiontable.h"
+
+const unsigned TranspositionTable::kDefaultSizeBits;
+
+/**
+ * Description: Constructs an empty table.
+ * Parameters: const unsigned& size_bits: The table holds 2^size_bits slots of
+ *     16 bytes each.
+ * Returns: Nothing.
+ */
+
+TranspositionTable::TranspositionTable(const unsigned& size_bits) :
+    slots_(new Slot[1ULL << size_bits]), mask_((1ULL << size_bits) - 1) {
+  Clear();
+}
+
+/**
+ * Description: Looks up a position.
+ * Parameters: const uint64_t& key: The position's hash.
+ * Entry& entry: An input parameter set to the stored entry on a hit.
+ * Returns: Whether the position was found.
+ */
+
+bool TranspositionTable::Probe(const uint64_t& key, Entry& entry) {
+  const Slot& slot = slots_[key & mask_];
+  uint64_t data = slot.data.load(std::memory_order_relaxed);
+  uint64_t check = slot.check.load(std::memory_order_relaxed);
+  num_probes_.fetch_add(1, std::memory_order_relaxed);
+
+  if ((check ^ data) != key || !data) {
+    return false;
+  }
+
+  num_hits_.fetch_add(1, std::memory_order_relaxed);
+  entry = Unpack(data);
+
+  return true;
+}
+
+/**
+ * Description: Saves a position. A slot holding another position is only
+ *     taken over by an entry searched at least as deep.
+ * Parameters: const uint64_t& key: The position's hash.
+ * const Entry& entry: What is known about the position.
+ * Returns: Nothing.
+ */
+
+void TranspositionTable::Store(const uint64_t& key, const Entry& entry) {
+  Slot& slot = slots_[key & mask_];
+  uint64_t old_data = slot.data.load(std::memory_order_relaxed);
+  uint64_t old_check = slot.check.load(std::memory_order_relaxed);
+
+  if (old_data && (old_check ^ old_data) != key) {
+    if (Unpack(old_data).depth > entry.depth) {
+      return;
+    }
+
+    num_overwrites_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  uint64_t data = Pack(entry);
+  slot.check.store(key ^ data, std::memory_order_relaxed);
+  slot.data.store(data, std::memory_order_relaxed);
+  num_stores_.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * Description: Empties every slot and resets the counters.
+ * Parameters: None.
+ * Returns: Nothing.
+ */
+
+void TranspositionTable::Clear() {
+  for (uint64_t i = 0; i <= mask_; i++) {
+    slots_[i].check.store(0, std::memory_order_relaxed);
+    slots_[i].data.store(0, std::memory_order_relaxed);
+  }
+
+  num_probes_ = 0;
+  num_hits_ = 0;
+  num_stores_ = 0;
+  num_overwrites_ = 0;
+}
+
+/**
+ * Description: Serializes the table's counters into a string.
+ * Parameters: None.
+ * Returns: The serialized counters.
+ */
+
+std::string TranspositionTable::ToString() const {
+  std::ostringstream summary;
+  summary << GetNumProbes() << " probes, " << GetHitRate() * 100
+          << "% hits, " << GetNumStores() << " stores, "
+          << GetNumOverwrites() << " overwrites in " << GetSize() << " slots";
+
+  return summary.str();
+}
+
+/**
+ * Description: Packs an entry into the low bytes of a word. The bound is
+ *     never zero, so an empty slot never reads as a stored entry.
+ * Parameters: const Entry& entry: The entry.
+ * Returns: The packed entry.
+ */
+
+uint64_t TranspositionTable::Pack(const Entry& entry) {
+  return (uint64_t) (uint8_t) entry.value | (uint64_t) entry.bound << 8 |
+      (uint64_t) entry.depth << 16 | (uint64_t) entry.move_index << 24;
+}
+
+/**
+ * Description: Unpacks an entry packed by Pack.
+ * Parameters: const uint64_t& data: The packed entry.
+ * Returns: The entry.
+ */
+
+TranspositionTable::Entry TranspositionTable::Unpack(const uint64_t& data) {
+  Entry entry;
+  entry.value = (int8_t) (data & 0xff);
+  entry.bound = (data >> 8) & 0xff;
+  entry.depth = (data >> 16) & 0xff;
+  entry.move_index = (data >> 24) & 0xff;
+
+  return entry;
+}
\ No newline at end of file
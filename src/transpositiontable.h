@@ -0,0 +1,77 @@
+#ifndef _TRANSPOSITION_TABLE_H_
+#define _TRANSPOSITION_TABLE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// A fixed-size table of solved positions keyed by Zobrist hash, shared by
+// search threads without locks. A slot keeps the key XORed with the data
+// next to the data, so a slot torn by two concurrent writes fails the key
+// check on the next probe instead of handing back another position's data.
+class TranspositionTable {
+ public:
+  // Public enums
+  enum Bound {
+    kExact = 1,
+    kLower,
+    kUpper
+  };
+
+  // Public structs
+  struct Entry {
+    int8_t value;
+    uint8_t bound;
+    uint8_t depth;
+    uint8_t move_index;
+  };
+
+  // Public constants
+  static const unsigned kDefaultSizeBits = 20;
+
+  // Delete copy constructor and assignment operator
+  TranspositionTable(const TranspositionTable& table) = delete;
+  TranspositionTable& operator=(const TranspositionTable& table) = delete;
+
+  // Constructors
+  TranspositionTable(const unsigned& size_bits = kDefaultSizeBits);
+
+  // Accessors
+  inline uint64_t GetSize() const { return mask_ + 1; }
+  inline uint64_t GetNumProbes() const { return num_probes_.load(); }
+  inline uint64_t GetNumHits() const { return num_hits_.load(); }
+  inline uint64_t GetNumStores() const { return num_stores_.load(); }
+  inline uint64_t GetNumOverwrites() const { return num_overwrites_.load(); }
+  inline double GetHitRate() const {
+    uint64_t num_probes = GetNumProbes();
+
+    return num_probes ? (double) GetNumHits() / num_probes : 0.0;
+  }
+
+  // Public utils
+  bool Probe(const uint64_t& key, Entry& entry);
+  void Store(const uint64_t& key, const Entry& entry);
+  void Clear();
+  std::string ToString() const;
+
+ private:
+  // Private structs
+  struct Slot {
+    std::atomic<uint64_t> check;
+    std::atomic<uint64_t> data;
+  };
+
+  std::unique_ptr<Slot[]> slots_;
+  uint64_t mask_;
+  std::atomic<uint64_t> num_probes_;
+  std::atomic<uint64_t> num_hits_;
+  std::atomic<uint64_t> num_stores_;
+  std::atomic<uint64_t> num_overwrites_;
+
+  // Private utils
+  static uint64_t Pack(const Entry& entry);
+  static Entry Unpack(const uint64_t& data);
+};
+
+#endif
\ No newline at end of file
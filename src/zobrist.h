@@ -0,0 +1,79 @@
+#ifndef _ZOBRIST_H_
+#define _ZOBRIST_H_
+
+#include <cstdint>
+#include "card.h"
+
+// Random keys for hashing a position, computed at compile time. A position
+// hashes to the XOR of the keys of everything in it, so every mutator keeps
+// its hash up to date with a few XORs.
+struct ZobristKeys {
+  uint64_t hand[2][Card::kNumCards];
+  uint64_t pile[2][Card::kNumCards];
+  uint64_t loose[Card::kNumCards];
+  uint64_t build_card[Card::kNumCards];
+  uint64_t build_owner[2];
+  uint64_t build_sum[16];
+  uint64_t last_captured[2];
+  uint64_t side[2];
+
+  constexpr ZobristKeys() : hand(), pile(), loose(), build_card(),
+      build_owner(), build_sum(), last_captured(), side() {
+    uint64_t state = 0x436173696e6f4350ULL;
+
+    for (unsigned id = 0; id < Card::kNumCards; id++) {
+      for (unsigned i = 0; i < 2; i++) {
+        hand[i][id] = SplitMix(state);
+        pile[i][id] = SplitMix(state);
+      }
+
+      loose[id] = SplitMix(state);
+      build_card[id] = SplitMix(state);
+    }
+
+    for (unsigned i = 0; i < 16; i++) {
+      build_sum[i] = SplitMix(state);
+    }
+
+    for (unsigned i = 0; i < 2; i++) {
+      build_owner[i] = SplitMix(state);
+      last_captured[i] = SplitMix(state);
+      side[i] = SplitMix(state);
+    }
+  }
+
+  static constexpr uint64_t SplitMix(uint64_t& state) {
+    uint64_t value = (state += 0x9e3779b97f4a7c15ULL);
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+
+    return value ^ (value >> 31);
+  }
+};
+
+constexpr ZobristKeys kZobristKeys;
+
+class Zobrist {
+ public:
+  // Public utils
+  static inline uint64_t HashCards(const uint64_t* keys, const uint64_t& mask) {
+    uint64_t hash = 0;
+    uint64_t rest = mask;
+
+    while (rest) {
+      hash ^= keys[__builtin_ctzll(rest)];
+      rest &= rest - 1;
+    }
+
+    return hash;
+  }
+
+  // Scrambles a build's key so that two builds never cancel each other out
+  static inline uint64_t Mix(const uint64_t& key) {
+    uint64_t state = key;
+
+    return ZobristKeys::SplitMix(state);
+  }
+};
+
+#endif
\ No newline at end of file
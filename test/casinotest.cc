@@ -0,0 +1,20 @@
+#include <cstring>
+#include <iostream>
+#include "testcase.h"
+
+// casinotest [--filter <text>] runs the tests whose names contain the text,
+// or all of them, and exits with 1 if any failed
+int main(int argc, char* argv[]) {
+  std::string filter;
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--filter") && i + 1 < argc) {
+      filter = argv[++i];
+    } else {
+      std::cerr << "Unknown argument: " << argv[i] << std::endl;
+      return 1;
+    }
+  }
+
+  return TestCase::RunAll(filter) ? 1 : 0;
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include "fixtures.h"
+#include "movegenerator.h"
+#include "movelog.h"
+#include "sanitizer.h"
+
+/**
+ * Description: Reads cards written as the prompts take them.
+ * Parameters: const std::string& symbols: The cards, separated by spaces.
+ * Returns: The cards.
+ */
+
+std::vector<Card> Fixtures::ParseCards(const std::string& symbols) {
+  std::vector<Card> cards;
+
+  for (const std::string& symbol : Sanitizer::TokenizeInput(symbols)) {
+    cards.push_back(Card(symbol));
+  }
+
+  return cards;
+}
+
+/**
+ * Description: Makes a build whose sum is that of its first set.
+ * Parameters: const std::vector<std::string>& sets: The sets' cards.
+ * const unsigned& owner_index: The number of the player who owns it.
+ * Returns: The build.
+ */
+
+std::shared_ptr<Build> Fixtures::MakeBuild(
+    const std::vector<std::string>& sets, const unsigned& owner_index) {
+  std::shared_ptr<Build> build(new Build);
+  unsigned build_sum = 0;
+
+  for (const Card& card : ParseCards(sets[0])) {
+    build_sum += card.GetValue();
+  }
+
+  for (const std::string& set : sets) {
+    build->AddToBuild(ParseCards(set));
+  }
+
+  build->SetBuildSum(build_sum);
+  build->SetOwnerIndex(owner_index);
+
+  return build;
+}
+
+/**
+ * Description: Makes a quiet greedy computer.
+ * Parameters: const std::string& hand: The cards in hand.
+ * const unsigned& number: The player's number.
+ * Returns: The computer.
+ */
+
+std::shared_ptr<Computer> Fixtures::MakeComputer(
+    const std::string& hand, const unsigned& number) {
+  std::shared_ptr<Computer> computer(new Computer);
+  computer->SetIsHuman(false);
+  computer->SetIsVerbose(false);
+  computer->SetNumber(number);
+  computer->SetHand(ParseCards(hand));
+
+  return computer;
+}
+
+/**
+ * Description: Lets the player make its own move, checking it against the
+ *     moves generated for the position first.
+ * Parameters: Player& player: The player.
+ * std::shared_ptr<Table>& table: The table.
+ * bool& is_generated: An input parameter set to whether the generator
+ *     listed the move.
+ * Returns: The move made, as the move log records it.
+ */
+
+Move Fixtures::PlayMove(Player& player, std::shared_ptr<Table>& table,
+    bool& is_generated) {
+  MoveGenerator generator;
+  MoveList moves;
+  MoveLog::Before before;
+  generator.Generate(player.GetHand(), player.GetNumber(), table, moves);
+  MoveLog::SaveBefore(player, *table, before);
+  player.MakeMove(table);
+  Move move = MoveLog::GetPlayedMove(before, player, *table);
+  is_generated = false;
+
+  for (unsigned i = 0; i < moves.GetSize(); i++) {
+    is_generated = is_generated || moves[i] == move;
+  }
+
+  return move;
+}
\ No newline at end of file
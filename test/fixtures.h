@@ -0,0 +1,32 @@
+#ifndef _FIXTURES_H_
+#define _FIXTURES_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "computer.h"
+#include "move.h"
+#include "table.h"
+
+// Positions set up by hand for the tests, with cards written as the prompts
+// take them ("HX DX S8").
+class Fixtures {
+ public:
+  // Public utils
+  static std::vector<Card> ParseCards(const std::string& symbols);
+
+  // A build of the given sets, each a string of cards, owned by a player
+  static std::shared_ptr<Build> MakeBuild(
+      const std::vector<std::string>& sets, const unsigned& owner_index);
+
+  // A quiet greedy computer holding the hand, playing as the given number
+  static std::shared_ptr<Computer> MakeComputer(const std::string& hand,
+      const unsigned& number);
+
+  // Lets the player make its own move, works it out the way the move log
+  // does and says whether the move generator listed it
+  static Move PlayMove(Player& player, std::shared_ptr<Table>& table,
+      bool& is_generated);
+};
+
+#endif
\ No newline at end of file
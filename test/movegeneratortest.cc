@@ -0,0 +1,24 @@
+#include "fixtures.h"
+#include "movegenerator.h"
+#include "testcase.h"
+
+TEST(AceMustCaptureOwnBuildOfFourteen) {
+  auto computer = Fixtures::MakeComputer("SA S4 HQ", 0);
+  std::shared_ptr<Table> table(new Table);
+  table->SetLooseCards(Fixtures::ParseCards("C3"));
+  table->AddBuild(Fixtures::MakeBuild({"S9 D5"}, 0));
+  MoveList moves;
+  MoveGenerator generator;
+  generator.Generate(computer->GetHand(), 0, table, moves);
+
+  CHECK(MoveGenerator::MustCapture(Card("SA"), 0, table));
+  CHECK(!MoveGenerator::MustCapture(Card("SA"), 1, table));
+
+  for (unsigned i = 0; i < moves.GetSize(); i++) {
+    CHECK(moves[i].card_index || moves[i].type == Move::kCapture);
+  }
+
+  bool is_generated;
+  Fixtures::PlayMove(*computer, table, is_generated);
+  CHECK(is_generated);
+}
\ No newline at end of file
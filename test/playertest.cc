@@ -0,0 +1,79 @@
+#include "bitboard.h"
+#include "fixtures.h"
+#include "random.h"
+#include "round.h"
+#include "testcase.h"
+
+// The computer's own moves must be ones the move generator lists, since
+// replays, the game server and the search all go by the generator.
+
+TEST(GreedyMovesAreGenerated) {
+  for (uint64_t seed = 0; seed < 50; seed++) {
+    Random rng(seed);
+    std::vector<std::shared_ptr<Player>> players;
+
+    for (unsigned i = 0; i < 2; i++) {
+      players.push_back(Fixtures::MakeComputer("", i));
+      players[i]->SetIsTurn(i == seed % 2);
+    }
+
+    std::shared_ptr<Deck> deck(new Deck(rng));
+    Round round(players, deck, 1);
+
+    while (round.PrepareMove()) {
+      std::shared_ptr<Table> table = round.GetTable();
+      bool is_generated;
+      Fixtures::PlayMove(*round.GetCurrentPlayer(), table, is_generated);
+      CHECK(is_generated);
+      round.Step(Round::kMoveMade);
+    }
+  }
+}
+
+TEST(CardMatchingOwnBuildOnlyCaptures) {
+  auto computer = Fixtures::MakeComputer("HX DX S8", 0);
+  std::shared_ptr<Table> table(new Table);
+  table->SetLooseCards(Fixtures::ParseCards("DK HJ"));
+  table->AddBuild(Fixtures::MakeBuild({"H7 H3"}, 0));
+  bool is_generated;
+  Move move = Fixtures::PlayMove(*computer, table, is_generated);
+
+  CHECK(is_generated);
+  CHECK(move.type == Move::kCapture);
+  CHECK(move.build_mask == 1);
+}
+
+TEST(SecondPlayerCapturesOpponentsBuild) {
+  auto computer = Fixtures::MakeComputer("S7 D2 DK CX", 1);
+  std::shared_ptr<Table> table(new Table);
+  table->AddBuild(Fixtures::MakeBuild({"H8 SA H4"}, 0));
+  bool is_generated;
+  Move move = Fixtures::PlayMove(*computer, table, is_generated);
+
+  CHECK(is_generated);
+  CHECK(move.type == Move::kCapture);
+  CHECK(move.build_mask == 1);
+  CHECK(!table->GetNumBuilds());
+  CHECK(Bitboard::Contains(computer->GetPileMask(), Card("H8")));
+}
+
+// A computer that opens up the capture search to the tests
+class SearchingComputer : public Computer {
+ public:
+  using Player::FindBestCapture;
+  using Player::GetCardScore;
+};
+
+TEST(AceCaptureTakesLooseAceOnce) {
+  SearchingComputer computer;
+  computer.SetHand(Fixtures::ParseCards("DA"));
+  std::shared_ptr<Table> table(new Table);
+  table->SetLooseCards(Fixtures::ParseCards("HA SK"));
+  Arena::Scope scratch;
+  CaptureNode* capture = computer.FindBestCapture(table);
+
+  CHECK(capture->GetLooseCardMask() == 1);
+  CHECK(!(capture->GetSetMask() & capture->GetLooseCardMask()));
+  CHECK(capture->GetScore() == computer.GetCardScore(Card("DA")) +
+      computer.GetCardScore(Card("HA")));
+}
\ No newline at end of file
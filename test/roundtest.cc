@@ -0,0 +1,92 @@
+#include "human.h"
+#include "inputsource.h"
+#include "movegenerator.h"
+#include "outputsink.h"
+#include "random.h"
+#include "round.h"
+#include "testcase.h"
+
+// A round between two humans dealt from a seed, reading from one queue the
+// way a remote table does, and keeping what it writes.
+struct QueuedRound {
+  std::vector<std::shared_ptr<Player>> players;
+  std::shared_ptr<InputQueue> input;
+  std::shared_ptr<MemoryOutput> output;
+  std::shared_ptr<Round> round;
+
+  QueuedRound(const uint64_t& seed) :
+      input(new InputQueue), output(new MemoryOutput) {
+    Random rng(seed);
+
+    for (unsigned i = 0; i < 2; i++) {
+      players.push_back(std::shared_ptr<Player>(new Human));
+      players[i]->SetIsHuman(true);
+      players[i]->SetIsVerbose(false);
+      players[i]->SetNumber(i);
+      players[i]->SetIsTurn(i == seed % 2);
+    }
+
+    std::shared_ptr<Deck> deck(new Deck(rng));
+    round = std::shared_ptr<Round>(new Round(players, deck, 1));
+    round->SetInput(input);
+    round->SetOutput(output);
+  }
+
+  // The menu choice, card and action that trail the current player's first
+  // card that may trail, or nothing if none may
+  std::vector<std::string> GetTrailLines() const {
+    const auto& player = round->GetCurrentPlayer();
+    const MoveList& moves = MoveGenerator::GenerateOnThread(
+        player->GetHand(), player->GetNumber(), round->GetTable());
+
+    for (unsigned i = 0; i < moves.GetSize(); i++) {
+      if (moves[i].type == Move::kTrail) {
+        return {"2", player->GetHand()[moves[i].card_index].ToString(), "3"};
+      }
+    }
+
+    return {};
+  }
+};
+
+// A round whose queue runs dry at any prompt, even right after the menu,
+// must stop and later go on to make the same moves as one given each turn
+// whole, without reading any line twice.
+
+TEST(RoundResumesWhereInputRanOut) {
+  for (uint64_t seed = 0; seed < 10; seed++) {
+    QueuedRound whole(seed);
+    QueuedRound trickled(seed);
+    whole.round->PlayRound();
+    trickled.round->PlayRound();
+    unsigned num_turns = 0;
+
+    while (whole.round->GetState() != Round::kOver) {
+      std::vector<std::string> lines = whole.GetTrailLines();
+
+      if (lines.empty()) {
+        break;
+      }
+
+      for (const std::string& line : lines) {
+        whole.input->Push(line);
+      }
+
+      whole.round->PlayRound();
+
+      for (const std::string& line : lines) {
+        trickled.input->Push(line);
+        trickled.round->PlayRound();
+      }
+
+      CHECK(!trickled.input->HasUnread());
+      CHECK(trickled.round->GetState() == whole.round->GetState());
+      CHECK(trickled.round->GetHash() == whole.round->GetHash());
+      num_turns++;
+    }
+
+    CHECK(num_turns > 0);
+    CHECK(trickled.output->GetText().find("Not a valid choice") ==
+        std::string::npos);
+  }
+}
\ No newline at end of file
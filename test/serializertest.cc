@@ -0,0 +1,99 @@
+#include <cstring>
+#include "fixtures.h"
+#include "random.h"
+#include "round.h"
+#include "serializer.h"
+#include "testcase.h"
+
+// Reads a binary round back into fresh players and writes it again.
+static bool Rewrite(const uint8_t* buffer, const unsigned& size,
+    uint8_t* rewritten, unsigned& rewritten_size) {
+  std::vector<std::shared_ptr<Player>> players;
+
+  for (unsigned i = 0; i < 2; i++) {
+    players.push_back(Fixtures::MakeComputer("", i));
+  }
+
+  unsigned round_num;
+  unsigned next_player;
+  std::shared_ptr<Table> table;
+  std::shared_ptr<Deck> deck;
+
+  if (!Serializer::ReadBinaryRound(buffer, size, players, round_num, table,
+      deck, next_player)) {
+    return false;
+  }
+
+  rewritten_size = Serializer::WriteBinaryRound(round_num, players, table,
+      *deck, next_player, rewritten);
+
+  return true;
+}
+
+// Every position of a game must save within the bound and read back to the
+// same bytes.
+
+TEST(SavedRoundsReadBack) {
+  for (uint64_t seed = 0; seed < 20; seed++) {
+    Random rng(seed);
+    std::vector<std::shared_ptr<Player>> players;
+
+    for (unsigned i = 0; i < 2; i++) {
+      players.push_back(Fixtures::MakeComputer("", i));
+      players[i]->SetIsTurn(i == seed % 2);
+    }
+
+    std::shared_ptr<Deck> deck(new Deck(rng));
+    Round round(players, deck, 1);
+
+    while (round.PrepareMove()) {
+      uint8_t buffer[Serializer::kMaxBinarySize];
+      uint8_t rewritten[Serializer::kMaxBinarySize];
+      unsigned size = round.GetBinaryData(buffer);
+      unsigned rewritten_size = 0;
+      CHECK(size <= Serializer::kMaxBinarySize);
+      CHECK(Rewrite(buffer, size, rewritten, rewritten_size));
+      CHECK(rewritten_size == size && !memcmp(buffer, rewritten, size));
+
+      std::shared_ptr<Table> table = round.GetTable();
+      bool is_generated;
+      Fixtures::PlayMove(*round.GetCurrentPlayer(), table, is_generated);
+      round.Step(Round::kMoveMade);
+    }
+  }
+}
+
+// The bound is reached with every card in builds of two single card sets.
+
+TEST(FullestRoundFillsBound) {
+  std::vector<std::shared_ptr<Player>> players;
+
+  for (unsigned i = 0; i < 2; i++) {
+    players.push_back(Fixtures::MakeComputer("", i));
+  }
+
+  std::shared_ptr<Table> table(new Table);
+  std::vector<std::shared_ptr<Build>> builds;
+
+  for (unsigned id = 0; id < Card::kNumCards; id += 2) {
+    builds.push_back(Fixtures::MakeBuild({Card::FromId(id).ToString(),
+        Card::FromId(id + 1).ToString()}, id % 4 / 2));
+  }
+
+  table->SetCurrentBuilds(builds);
+  Deck deck(std::vector<Card>{});
+  uint8_t buffer[Serializer::kMaxBinarySize];
+  uint8_t rewritten[Serializer::kMaxBinarySize];
+  unsigned size =
+      Serializer::WriteBinaryRound(1, players, table, deck, 0, buffer);
+  unsigned rewritten_size = 0;
+  CHECK(size == Serializer::kMaxBinarySize);
+  CHECK(Rewrite(buffer, size, rewritten, rewritten_size));
+  CHECK(rewritten_size == size && !memcmp(buffer, rewritten, size));
+  CHECK(!Rewrite(buffer, size - 1, rewritten, rewritten_size));
+}
+
+TEST(ConvertReportsMissingFile) {
+  CHECK(!Serializer::ConvertSaveFile("test/no-such-save.txt",
+      "test/no-such-save.bin"));
+}
\ No newline at end of file
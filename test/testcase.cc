@@ -0,0 +1,88 @@
+#include <iostream>
+#include "testcase.h"
+
+/**
+ * Description: Adds a test to the ones RunAll runs. Called by TEST before
+ *     main starts.
+ * Parameters: const char* name: The test's name.
+ * void (*run)(): The test.
+ * Returns: True, so TEST can call it from an initializer.
+ */
+
+bool TestCase::Register(const char* name, void (*run)()) {
+  GetEntries().push_back(Entry{name, run});
+  return true;
+}
+
+/**
+ * Description: Records one check, printing it if it failed.
+ * Parameters: const bool& passed: Whether the check passed.
+ * const char* expression: The expression checked.
+ * const char* file: The file the check is in.
+ * const unsigned& line: The line the check is on.
+ * Returns: Nothing.
+ */
+
+void TestCase::Check(const bool& passed, const char* expression,
+    const char* file, const unsigned& line) {
+  if (passed) {
+    return;
+  }
+
+  std::cout << "  " << file << ':' << line << ": CHECK(" << expression
+            << ") failed" << std::endl;
+  GetNumFailedChecks()++;
+}
+
+/**
+ * Description: Runs every test whose name contains the filter, printing
+ *     whether each passed.
+ * Parameters: const std::string& filter: The filter; empty runs them all.
+ * Returns: The number of tests that failed.
+ */
+
+unsigned TestCase::RunAll(const std::string& filter) {
+  unsigned num_run = 0;
+  unsigned num_failed = 0;
+
+  for (const Entry& entry : GetEntries()) {
+    if (std::string(entry.name).find(filter) == std::string::npos) {
+      continue;
+    }
+
+    unsigned num_failed_checks = GetNumFailedChecks();
+    entry.run();
+    bool passed = (GetNumFailedChecks() == num_failed_checks);
+    std::cout << (passed ? "PASS " : "FAIL ") << entry.name << std::endl;
+    num_run++;
+    num_failed += !passed;
+  }
+
+  std::cout << num_run - num_failed << '/' << num_run << " tests passed"
+            << std::endl;
+
+  return num_failed;
+}
+
+/**
+ * Description: Gets the registered tests. Held in a function so that
+ *     registering from other files' initializers is safe.
+ * Parameters: None.
+ * Returns: The tests.
+ */
+
+std::vector<TestCase::Entry>& TestCase::GetEntries() {
+  static std::vector<Entry> entries;
+  return entries;
+}
+
+/**
+ * Description: Gets the number of checks that have failed so far.
+ * Parameters: None.
+ * Returns: The count.
+ */
+
+unsigned& TestCase::GetNumFailedChecks() {
+  static unsigned num_failed_checks = 0;
+  return num_failed_checks;
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#ifndef _TEST_CASE_H_
+#define _TEST_CASE_H_
+
+#include <string>
+#include <vector>
+
+// The tests run by bin/casinotest. Each test file defines its tests with TEST
+// and checks what they find with CHECK; a test fails if any of its checks
+// does, and the run fails if any test does.
+class TestCase {
+ public:
+  // Public utils
+  static bool Register(const char* name, void (*run)());
+  static void Check(const bool& passed, const char* expression,
+      const char* file, const unsigned& line);
+  static unsigned RunAll(const std::string& filter);
+
+ private:
+  // Private structs
+  struct Entry {
+    const char* name;
+    void (*run)();
+  };
+
+  // Private utils
+  static std::vector<Entry>& GetEntries();
+  static unsigned& GetNumFailedChecks();
+};
+
+#define TEST(name) \
+  static void name(); \
+  static const bool name##_is_registered \
+      __attribute__((unused)) = TestCase::Register(#name, name); \
+  static void name()
+
+#define CHECK(expression) \
+  TestCase::Check((expression), #expression, __FILE__, __LINE__)
+
+#endif
\ No newline at end of file